@@ -0,0 +1,215 @@
+// core/Assignment.c
+// Implementation of the nearest / second-nearest ring station cache
+
+#include "Assignment.h"
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+Assignment* Assignment_Create(int total_stations)
+{
+    Assignment* a = (Assignment*)malloc(sizeof(Assignment));
+    if (!a) return NULL;
+
+    a->total_stations = total_stations;
+    a->nearest = (int*)calloc(total_stations + 1, sizeof(int));
+    a->second = (int*)calloc(total_stations + 1, sizeof(int));
+    a->in_ring = (uint32_t*)calloc(BITSET_WORDS(total_stations), sizeof(uint32_t));
+    a->out_dist = 0;
+
+    if (!a->nearest || !a->second || !a->in_ring) {
+        Assignment_Destroy(a);
+        return NULL;
+    }
+    return a;
+}
+
+void Assignment_Destroy(Assignment* a)
+{
+    if (!a) return;
+    free(a->nearest);
+    free(a->second);
+    free(a->in_ring);
+    free(a);
+}
+
+void Assignment_Copy(Assignment* dest, const Assignment* src)
+{
+    if (!dest || !src || dest->total_stations != src->total_stations) return;
+
+    int n = src->total_stations + 1;
+    memcpy(dest->nearest, src->nearest, n * sizeof(int));
+    memcpy(dest->second, src->second, n * sizeof(int));
+    memcpy(dest->in_ring, src->in_ring, BITSET_WORDS(src->total_stations) * sizeof(uint32_t));
+    dest->out_dist = src->out_dist;
+}
+
+void Assignment_Build(
+    Assignment* a,
+    const gene_t* active_ring, int ring_size,
+    const DistMatrix* dist, const Ranking* ranking)
+{
+    if (!a || !active_ring || !dist || !ranking) return;
+
+    int n = a->total_stations;
+    Bitset_FromRing(a->in_ring, n, active_ring, ring_size);
+
+    a->out_dist = 0;
+    a->nearest[0] = a->second[0] = 0;
+
+    for (int t = 1; t <= n; ++t) {
+        a->nearest[t] = Ranking_FirstActive(ranking, a->in_ring, t, 0, dist);
+        a->second[t] = (a->nearest[t] > 0) ? Ranking_FirstActive(ranking, a->in_ring, t, a->nearest[t], dist) : 0;
+
+        if (!BITSET_TEST(a->in_ring, t) && a->nearest[t] > 0) {
+            a->out_dist += DIST(dist, t - 1, a->nearest[t] - 1);
+        }
+    }
+}
+
+Assignment* Assignment_Attach(
+    Individual* ind, int total_stations,
+    const DistMatrix* dist, const Ranking* ranking)
+{
+    if (!ind) return NULL;
+    if (ind->assign) return ind->assign;
+
+    ind->assign = Assignment_Create(total_stations);
+    if (ind->assign) {
+        Assignment_Build(ind->assign, ind->active_ring, ind->ring_size, dist, ranking);
+    }
+    return ind->assign;
+}
+
+// =============================================================================
+// QUERIES
+// =============================================================================
+
+int Assignment_Of(const Assignment* a, int station)
+{
+    if (!a || station < 1 || station > a->total_stations) return 0;
+    return BITSET_TEST(a->in_ring, station) ? station : a->nearest[station];
+}
+
+cost_t Assignment_OutCost(const Assignment* a, int alpha)
+{
+    return (10 - alpha) * a->out_dist;
+}
+
+// =============================================================================
+// DELTAS
+// =============================================================================
+
+cost_t Assignment_DeltaInsert(const Assignment* a, int station, const DistMatrix* dist)
+{
+    int n = a->total_stations;
+    cost_t delta = 0;
+
+    // The inserted station no longer pays its own assignment
+    if (a->nearest[station] > 0) {
+        delta -= DIST(dist, station - 1, a->nearest[station] - 1);
+    }
+
+    // Non-ring stations closer to the new node than to their current one
+    for (int t = 1; t <= n; ++t) {
+        if (t == station || BITSET_TEST(a->in_ring, t)) continue;
+        int cur = a->nearest[t];
+        cost_t d_new = DIST(dist, station - 1, t - 1);
+        if (cur == 0) {
+            delta += d_new;
+        } else {
+            cost_t diff = d_new - DIST(dist, t - 1, cur - 1);
+            if (diff < 0) delta += diff;
+        }
+    }
+
+    return delta;
+}
+
+cost_t Assignment_DeltaRemove(const Assignment* a, int station, const DistMatrix* dist)
+{
+    int n = a->total_stations;
+    cost_t delta = 0;
+
+    // The removed station is assigned to its nearest remaining ring station
+    if (a->nearest[station] > 0) {
+        delta += DIST(dist, station - 1, a->nearest[station] - 1);
+    }
+
+    // Its clients fall back to their second-nearest ring station
+    for (int t = 1; t <= n; ++t) {
+        if (a->nearest[t] != station || BITSET_TEST(a->in_ring, t)) continue;
+        if (a->second[t] > 0) {
+            delta += DIST(dist, t - 1, a->second[t] - 1) - DIST(dist, station - 1, t - 1);
+        }
+    }
+
+    return delta;
+}
+
+// =============================================================================
+// UPDATES
+// =============================================================================
+
+void Assignment_Insert(Assignment* a, int station, const DistMatrix* dist)
+{
+    if (!a || station < 1 || station > a->total_stations) return;
+    if (BITSET_TEST(a->in_ring, station)) return;
+
+    int n = a->total_stations;
+
+    if (a->nearest[station] > 0) {
+        a->out_dist -= DIST(dist, station - 1, a->nearest[station] - 1);
+    }
+    BITSET_SET(a->in_ring, station);
+
+    for (int t = 1; t <= n; ++t) {
+        if (t == station) continue;
+
+        cost_t d_new = DIST(dist, station - 1, t - 1);
+        int cur = a->nearest[t];
+
+        if (cur == 0 || d_new < DIST(dist, t - 1, cur - 1)) {
+            if (!BITSET_TEST(a->in_ring, t)) {
+                a->out_dist += d_new - (cur > 0 ? DIST(dist, t - 1, cur - 1) : 0);
+            }
+            a->second[t] = cur;
+            a->nearest[t] = station;
+        } else if (a->second[t] == 0 || d_new < DIST(dist, t - 1, a->second[t] - 1)) {
+            a->second[t] = station;
+        }
+    }
+}
+
+void Assignment_Remove(
+    Assignment* a, int station,
+    const DistMatrix* dist, const Ranking* ranking)
+{
+    if (!a || station < 1 || station > a->total_stations) return;
+    if (!BITSET_TEST(a->in_ring, station)) return;
+
+    int n = a->total_stations;
+
+    BITSET_CLEAR(a->in_ring, station);
+    if (a->nearest[station] > 0) {
+        a->out_dist += DIST(dist, station - 1, a->nearest[station] - 1);
+    }
+
+    // Only stations that referenced the removed node need a rescan
+    for (int t = 1; t <= n; ++t) {
+        if (a->nearest[t] == station) {
+            int next = a->second[t];
+            if (!BITSET_TEST(a->in_ring, t)) {
+                a->out_dist += (next > 0 ? DIST(dist, t - 1, next - 1) : 0)
+                             - DIST(dist, t - 1, station - 1);
+            }
+            a->nearest[t] = next;
+            a->second[t] = (next > 0) ? Ranking_FirstActive(ranking, a->in_ring, t, next, dist) : 0;
+        } else if (a->second[t] == station) {
+            a->second[t] = Ranking_FirstActive(ranking, a->in_ring, t, a->nearest[t], dist);
+        }
+    }
+}
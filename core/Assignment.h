@@ -0,0 +1,82 @@
+// core/Assignment.h
+// Per-individual assignment cache: nearest and second-nearest ring station
+//
+// For every station t (1-indexed) the cache stores:
+//   nearest[t] - nearest ring station other than t itself (0 if none)
+//   second[t]  - second-nearest ring station other than t (0 if none)
+//
+// A non-ring station is served by nearest[t]. For a ring station, nearest[t]
+// is where it would be assigned if it left the ring, which makes the cost of
+// a removal exact in O(1) per station.
+//
+// Updates after a membership change are local:
+//   - Insert: one compare per station, no ranking scan
+//   - Remove: only stations whose nearest or second was the removed node
+//             rescan their ranking row
+//
+// The cache is optional: Individual.assign is NULL unless attached.
+
+#ifndef ASSIGNMENT_H
+#define ASSIGNMENT_H
+
+#include "core\Individual.h"
+#include "utils\Ranking.h"
+
+typedef struct Assignment {
+    int total_stations;
+    int* nearest;           // [total_stations + 1]
+    int* second;            // [total_stations + 1]
+    uint32_t* in_ring;      // Ring membership bitset (utils/Bitset.h)
+    cost_t out_dist;        // Sum of dist(t, nearest[t]) over non-ring stations
+} Assignment;
+
+// Allocate an empty cache for total_stations stations
+Assignment* Assignment_Create(int total_stations);
+
+// Free the cache (NULL is accepted)
+void Assignment_Destroy(Assignment* a);
+
+// Copy src into dest (same total_stations)
+void Assignment_Copy(Assignment* dest, const Assignment* src);
+
+// Rebuild the whole cache from a ring: O(N * ranking scan)
+void Assignment_Build(
+    Assignment* a,
+    const gene_t* active_ring, int ring_size,
+    const DistMatrix* dist, const Ranking* ranking
+);
+
+// Create and build ind->assign if missing. Returns the cache (NULL on error).
+Assignment* Assignment_Attach(
+    Individual* ind, int total_stations,
+    const DistMatrix* dist, const Ranking* ranking
+);
+
+// Ring station serving 'station' (itself if it is in the ring, 0 if none)
+int Assignment_Of(const Assignment* a, int station);
+
+// Out-of-ring cost: (10 - alpha) * out_dist
+cost_t Assignment_OutCost(const Assignment* a, int alpha);
+
+// =============================================================================
+// DELTAS (call before the move; unweighted, multiply by (10 - alpha))
+// =============================================================================
+
+// Change of out_dist if 'station' (not in ring) joins the ring
+cost_t Assignment_DeltaInsert(const Assignment* a, int station, const DistMatrix* dist);
+
+// Change of out_dist if 'station' (in ring) leaves the ring
+cost_t Assignment_DeltaRemove(const Assignment* a, int station, const DistMatrix* dist);
+
+// =============================================================================
+// UPDATES (call after the ring itself was modified)
+// =============================================================================
+
+void Assignment_Insert(Assignment* a, int station, const DistMatrix* dist);
+
+void Assignment_Remove(
+    Assignment* a, int station,
+    const DistMatrix* dist, const Ranking* ranking
+);
+
+#endif // ASSIGNMENT_H
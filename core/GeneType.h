@@ -0,0 +1,32 @@
+// core/GeneType.h
+// Station id type of rings (genes) and ranking rows
+//
+// Default mode:
+//   gene_t = uint16_t, instances of up to 65,535 stations. Rings are copied,
+//   crossed over and scanned every generation; half-width ids halve that
+//   memory traffic and the size of the species arenas.
+//
+// Wide mode (WIDE_IDS, also implied by the former RANKING_WIDE_IDS):
+//   gene_t = int32_t, for larger instances
+//
+// Only storage uses gene_t: ids are read into int for arithmetic, so code
+// outside the ring and ranking buffers is the same in both modes.
+
+#ifndef GENE_TYPE_H
+#define GENE_TYPE_H
+
+#include <stdint.h>
+
+#if defined(RANKING_WIDE_IDS) && !defined(WIDE_IDS)
+#define WIDE_IDS
+#endif
+
+#ifdef WIDE_IDS
+typedef int32_t gene_t;
+#define GENE_MAX_STATIONS 2147483647
+#else
+typedef uint16_t gene_t;
+#define GENE_MAX_STATIONS 65535
+#endif
+
+#endif // GENE_TYPE_H
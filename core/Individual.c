@@ -1,5 +1,6 @@
 // core/Individual.c - Pure C implementation
 #include "Individual.h"
+#include "Assignment.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -14,7 +15,9 @@ Individual* Individual_Create(int capacity)
 void Individual_Init(Individual* ind, int capacity)
 {
     if (!ind) return;
-    ind->active_ring = (int*)malloc(capacity * sizeof(int));
+    ind->active_ring = (gene_t*)malloc(capacity * sizeof(gene_t));
+    ind->assign = NULL;
+    ind->position = NULL;
     if (!ind->active_ring) {
         ind->ring_size = 0;
         ind->ring_capacity = 0;
@@ -33,6 +36,10 @@ void Individual_Free(Individual* ind)
         free(ind->active_ring);
         ind->active_ring = NULL;
     }
+    Assignment_Destroy(ind->assign);
+    ind->assign = NULL;
+    free(ind->position);
+    ind->position = NULL;
     ind->ring_size = 0;
     ind->ring_capacity = 0;
     ind->cached_cost = 1e18;
@@ -42,14 +49,76 @@ void Individual_Copy(Individual* dest, const Individual* src)
 {
     if (!dest || !src) return;
 
+    Individual_ClearPositions(dest);
+
     if (src->ring_size > dest->ring_capacity) {
-        int* new_ring = (int*)realloc(dest->active_ring, src->ring_size * sizeof(int));
+        gene_t* new_ring = (gene_t*)realloc(dest->active_ring, src->ring_size * sizeof(gene_t));
         if (!new_ring) return;
         dest->active_ring = new_ring;
         dest->ring_capacity = src->ring_size;
     }
 
-    memcpy(dest->active_ring, src->active_ring, src->ring_size * sizeof(int));
+    memcpy(dest->active_ring, src->active_ring, src->ring_size * sizeof(gene_t));
     dest->ring_size = src->ring_size;
     dest->cached_cost = src->cached_cost;
+    Individual_SyncPositions(dest, 0, dest->ring_size - 1);
+
+    if (src->assign) {
+        if (!dest->assign) dest->assign = Assignment_Create(src->assign->total_stations);
+        if (dest->assign) Assignment_Copy(dest->assign, src->assign);
+    } else if (dest->assign) {
+        Assignment_Destroy(dest->assign);
+        dest->assign = NULL;
+    }
+}
+
+// =============================================================================
+// POSITION INDEX
+// =============================================================================
+
+void Individual_AttachPositions(Individual* ind, gene_t* storage)
+{
+    if (!ind || ind->position) return;
+    if (!storage) {
+        storage = (gene_t*)malloc((ind->ring_capacity + 1) * sizeof(gene_t));
+        if (!storage) return;
+    }
+    ind->position = storage;
+    Individual_RebuildPositions(ind);
+}
+
+void Individual_RebuildPositions(Individual* ind)
+{
+    if (!ind || !ind->position) return;
+    for (int s = 0; s <= ind->ring_capacity; s++) {
+        ind->position[s] = RING_POS_NONE;
+    }
+    Individual_SyncPositions(ind, 0, ind->ring_size - 1);
+}
+
+void Individual_ClearPositions(Individual* ind)
+{
+    if (!ind || !ind->position) return;
+    for (int i = 0; i < ind->ring_size; i++) {
+        ind->position[ind->active_ring[i]] = RING_POS_NONE;
+    }
+}
+
+void Individual_SyncPositions(Individual* ind, int from, int to)
+{
+    if (!ind || !ind->position) return;
+    for (int i = from; i <= to; i++) {
+        ind->position[ind->active_ring[i]] = (gene_t)i;
+    }
+}
+
+int Individual_BorrowPositions(Individual* ind, gene_t* storage, int total_stations)
+{
+    if (!ind || ind->position || !storage) return 0;
+    for (int s = 0; s <= total_stations; s++) {
+        storage[s] = RING_POS_NONE;
+    }
+    ind->position = storage;
+    Individual_SyncPositions(ind, 0, ind->ring_size - 1);
+    return 1;
 }
@@ -1,12 +1,31 @@
 #pragma once
 
+#include "core\CostType.h"
+#include "core\GeneType.h"
+
+struct Assignment;
+
+// Position of a station that is not on the ring
+#define RING_POS_NONE ((gene_t)-1)
+
 typedef struct {
-    int* active_ring;
+    gene_t* active_ring;
     int ring_size;
     int ring_capacity;
-    double cached_cost;
+    cost_t cached_cost;
+    struct Assignment* assign;  // Optional assignment cache (NULL if not attached)
+    gene_t* position;           // Optional inverse index (NULL if not attached):
+                                // position[s] = slot of station s in active_ring,
+                                // RING_POS_NONE if out, ring_capacity + 1 entries
 } Individual;
 
+// O(1) ring queries, position index required
+#define RING_CONTAINS(ind, s) ((ind)->position[s] != RING_POS_NONE)
+#define RING_NEXT(ind, s) \
+    ((ind)->active_ring[((ind)->position[s] + 1 == (ind)->ring_size) ? 0 : (ind)->position[s] + 1])
+#define RING_PREV(ind, s) \
+    ((ind)->active_ring[((ind)->position[s] == 0) ? (ind)->ring_size - 1 : (ind)->position[s] - 1])
+
 // Allocate a new Individual on heap
 Individual* Individual_Create(int capacity);
 // Initialize an existing Individual struct (allocates internal buffer)
@@ -14,4 +33,33 @@ void Individual_Init(Individual* ind, int capacity);
 // Free internal buffers but DO NOT free the struct itself
 void Individual_Free(Individual* ind);
 // Copy contents from src to dest (dest must have sufficient capacity or will be reallocated)
-void Individual_Copy(Individual* dest, const Individual* src);
\ No newline at end of file
+// The assignment cache follows src: copied if present, dropped otherwise
+// The position index of dest (if attached) is updated for the new ring
+void Individual_Copy(Individual* dest, const Individual* src);
+
+// =============================================================================
+// POSITION INDEX
+// =============================================================================
+// Every routine that reorders a ring (mutations, crossover, 2-opt) keeps an
+// attached index in sync, at the cost of the slots it already touches.
+
+// Attach a position index (storage: ring_capacity + 1 entries, NULL to
+// allocate one owned by the individual) and build it. Station ids index it
+// directly: the ring capacity must be the number of stations (arena slots).
+// Caller-provided storage must be detached (position = NULL) before
+// Individual_Free.
+void Individual_AttachPositions(Individual* ind, gene_t* storage);
+
+// Rebuild the whole index from the ring (O(capacity))
+void Individual_RebuildPositions(Individual* ind);
+
+// Mark the stations currently in the ring as out (before overwriting it)
+void Individual_ClearPositions(Individual* ind);
+
+// Refresh the index of slots [from, to] after they were rewritten
+void Individual_SyncPositions(Individual* ind, int from, int to);
+
+// Give an individual without an index a temporary one in storage
+// (total_stations + 1 entries, any ring capacity). Returns 1 if storage was
+// attached: the caller sets ind->position back to NULL when done.
+int Individual_BorrowPositions(Individual* ind, gene_t* storage, int total_stations);
\ No newline at end of file
@@ -0,0 +1,360 @@
+// core/TwoLevelList.c
+// Implementation of the two-level doubly-linked list tour
+
+#include "TwoLevelList.h"
+#include <math.h>
+#include <stdlib.h>
+
+// Segment ends and node order in tour direction
+#define SEG_HEAD(S) ((S)->reversed ? (S)->last : (S)->first)
+#define SEG_TAIL(S) ((S)->reversed ? (S)->first : (S)->last)
+#define TOUR_RANK(tl, s) \
+    ((tl)->segments[(tl)->nodes[s].parent].reversed ? -(tl)->nodes[s].rank : (tl)->nodes[s].rank)
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+TwoLevelList* TwoLevelList_Create(int max_id)
+{
+    if (max_id <= 0) return NULL;
+
+    TwoLevelList* tl = (TwoLevelList*)calloc(1, sizeof(TwoLevelList));
+    if (!tl) return NULL;
+
+    tl->max_id = max_id;
+    tl->nodes = (TLNode*)calloc(max_id + 1, sizeof(TLNode));
+    tl->segments = (TLSegment*)calloc(max_id, sizeof(TLSegment));
+    if (!tl->nodes || !tl->segments) {
+        TwoLevelList_Free(tl);
+        return NULL;
+    }
+    return tl;
+}
+
+void TwoLevelList_Free(TwoLevelList* tl)
+{
+    if (!tl) return;
+    free(tl->nodes);
+    free(tl->segments);
+    free(tl);
+}
+
+// =============================================================================
+// CONVERSION
+// =============================================================================
+
+void TwoLevelList_FromRing(TwoLevelList* tl, const gene_t* ring, int m)
+{
+    int group = (int)sqrt((double)m);
+    if (group < 1) group = 1;
+    int count = (m + group - 1) / group;
+
+    tl->size = m;
+    tl->num_segments = count;
+
+    for (int g = 0; g < count; g++) {
+        int from = g * group;
+        int to = (from + group < m) ? from + group : m;
+        TLSegment* S = &tl->segments[g];
+
+        S->reversed = 0;
+        S->first = ring[from];
+        S->last = ring[to - 1];
+        S->prev = (g - 1 + count) % count;
+        S->next = (g + 1) % count;
+        S->rank = g;
+        S->size = to - from;
+
+        for (int i = from; i < to; i++) {
+            TLNode* u = &tl->nodes[ring[i]];
+            u->parent = g;
+            u->prev = (i > from) ? ring[i - 1] : 0;
+            u->next = (i + 1 < to) ? ring[i + 1] : 0;
+            u->rank = i;
+        }
+    }
+}
+
+void TwoLevelList_ToRing(const TwoLevelList* tl, gene_t* ring, int first)
+{
+    int s = first;
+    for (int i = 0; i < tl->size; i++) {
+        ring[i] = (gene_t)s;
+        s = TwoLevelList_Next(tl, s);
+    }
+}
+
+// =============================================================================
+// QUERIES
+// =============================================================================
+
+int TwoLevelList_Next(const TwoLevelList* tl, int s)
+{
+    const TLSegment* S = &tl->segments[tl->nodes[s].parent];
+    if (s == SEG_TAIL(S)) {
+        const TLSegment* N = &tl->segments[S->next];
+        return SEG_HEAD(N);
+    }
+    return S->reversed ? tl->nodes[s].prev : tl->nodes[s].next;
+}
+
+int TwoLevelList_Prev(const TwoLevelList* tl, int s)
+{
+    const TLSegment* S = &tl->segments[tl->nodes[s].parent];
+    if (s == SEG_HEAD(S)) {
+        const TLSegment* P = &tl->segments[S->prev];
+        return SEG_TAIL(P);
+    }
+    return S->reversed ? tl->nodes[s].next : tl->nodes[s].prev;
+}
+
+// Order of s on the tour read from a (a is 0): segment offset, then rank
+static void tour_key(const TwoLevelList* tl, int a, int s, int* seg_key, int* node_key)
+{
+    int sa = tl->nodes[a].parent;
+    int ss = tl->nodes[s].parent;
+    int offset = (tl->segments[ss].rank - tl->segments[sa].rank + tl->num_segments)
+               % tl->num_segments;
+    if (ss == sa && TOUR_RANK(tl, s) < TOUR_RANK(tl, a)) offset = tl->num_segments;
+    *seg_key = offset;
+    *node_key = TOUR_RANK(tl, s);
+}
+
+int TwoLevelList_Between(const TwoLevelList* tl, int a, int b, int c)
+{
+    int sb, nb, sc, nc;
+    tour_key(tl, a, b, &sb, &nb);
+    tour_key(tl, a, c, &sc, &nc);
+    return (sb < sc) || (sb == sc && nb <= nc);
+}
+
+// =============================================================================
+// NODE MOVES BETWEEN SEGMENTS
+// =============================================================================
+
+// Detach the first / last station of S in tour direction
+static int pop_head(TwoLevelList* tl, TLSegment* S)
+{
+    int u = SEG_HEAD(S);
+    if (!S->reversed) {
+        S->first = tl->nodes[u].next;
+        tl->nodes[S->first].prev = 0;
+    } else {
+        S->last = tl->nodes[u].prev;
+        tl->nodes[S->last].next = 0;
+    }
+    S->size--;
+    return u;
+}
+
+static int pop_tail(TwoLevelList* tl, TLSegment* S)
+{
+    int u = SEG_TAIL(S);
+    if (!S->reversed) {
+        S->last = tl->nodes[u].prev;
+        tl->nodes[S->last].next = 0;
+    } else {
+        S->first = tl->nodes[u].next;
+        tl->nodes[S->first].prev = 0;
+    }
+    S->size--;
+    return u;
+}
+
+// Attach station u after the last / before the first station of segment
+// index g in tour direction
+static void push_tail(TwoLevelList* tl, int g, int u)
+{
+    TLSegment* S = &tl->segments[g];
+    TLNode* n = &tl->nodes[u];
+    n->parent = g;
+    if (!S->reversed) {
+        n->prev = S->last;
+        n->next = 0;
+        n->rank = tl->nodes[S->last].rank + 1;
+        tl->nodes[S->last].next = u;
+        S->last = u;
+    } else {
+        n->next = S->first;
+        n->prev = 0;
+        n->rank = tl->nodes[S->first].rank - 1;
+        tl->nodes[S->first].prev = u;
+        S->first = u;
+    }
+    S->size++;
+}
+
+static void push_head(TwoLevelList* tl, int g, int u)
+{
+    TLSegment* S = &tl->segments[g];
+    TLNode* n = &tl->nodes[u];
+    n->parent = g;
+    if (!S->reversed) {
+        n->next = S->first;
+        n->prev = 0;
+        n->rank = tl->nodes[S->first].rank - 1;
+        tl->nodes[S->first].prev = u;
+        S->first = u;
+    } else {
+        n->prev = S->last;
+        n->next = 0;
+        n->rank = tl->nodes[S->last].rank + 1;
+        tl->nodes[S->last].next = u;
+        S->last = u;
+    }
+    S->size++;
+}
+
+// Stations of the segment of s before s, in tour direction
+static int head_distance(const TwoLevelList* tl, int s)
+{
+    const TLSegment* S = &tl->segments[tl->nodes[s].parent];
+    return S->reversed ? tl->nodes[S->last].rank - tl->nodes[s].rank
+                       : tl->nodes[s].rank - tl->nodes[S->first].rank;
+}
+
+// Make a the head of a segment: the stations before it move to the previous
+// segment, or a and the stations after it to the next one
+static void split_before(TwoLevelList* tl, int a)
+{
+    int g = tl->nodes[a].parent;
+    TLSegment* S = &tl->segments[g];
+    int before = head_distance(tl, a);
+    if (before == 0) return;
+
+    if (before <= S->size - before) {
+        while (SEG_HEAD(S) != a) push_tail(tl, S->prev, pop_head(tl, S));
+    } else {
+        int u;
+        do {
+            u = pop_tail(tl, S);
+            push_head(tl, S->next, u);
+        } while (u != a);
+    }
+}
+
+// Make b the tail of a segment without moving stations in front of the
+// segment 'keep' (whose head must stay its head)
+static void split_after(TwoLevelList* tl, int b, int keep)
+{
+    int g = tl->nodes[b].parent;
+    TLSegment* S = &tl->segments[g];
+    int through = head_distance(tl, b) + 1;
+    if (through == S->size) return;
+
+    if (S->next == keep || through <= S->size - through) {
+        int u;
+        do {
+            u = pop_head(tl, S);
+            push_tail(tl, S->prev, u);
+        } while (u != b);
+    } else {
+        while (SEG_TAIL(S) != b) push_head(tl, S->next, pop_tail(tl, S));
+    }
+}
+
+// =============================================================================
+// REVERSAL
+// =============================================================================
+
+// Reverse the path a..b inside one segment (a before b in tour direction)
+static void reverse_in_segment(TwoLevelList* tl, int a, int b)
+{
+    TLSegment* S = &tl->segments[tl->nodes[a].parent];
+    int x = S->reversed ? b : a;   // Path ends in the segment's own order
+    int y = S->reversed ? a : b;
+    int xp = tl->nodes[x].prev;
+    int yn = tl->nodes[y].next;
+    int rank = tl->nodes[y].rank;
+
+    int u = x;
+    for (;;) {
+        TLNode* n = &tl->nodes[u];
+        int next = n->next;
+        n->next = n->prev;
+        n->prev = next;
+        n->rank = rank--;
+        if (u == y) break;
+        u = next;
+    }
+
+    tl->nodes[y].prev = xp;
+    tl->nodes[x].next = yn;
+    if (xp) tl->nodes[xp].next = y; else S->first = y;
+    if (yn) tl->nodes[yn].prev = x; else S->last = x;
+}
+
+// Reverse the run of count whole segments starting at segment index g
+static void reverse_segments(TwoLevelList* tl, int g, int count)
+{
+    TLSegment* segs = tl->segments;
+    int last = g;
+    for (int k = 1; k < count; k++) last = segs[last].next;
+
+    // The run keeps its rank values, in reverse order
+    int i = g, j = last;
+    for (int k = 0; k < count / 2; k++) {
+        int r = segs[i].rank;
+        segs[i].rank = segs[j].rank;
+        segs[j].rank = r;
+        i = segs[i].next;
+        j = segs[j].prev;
+    }
+
+    int before = segs[g].prev;
+    int after = segs[last].next;
+    int s = g;
+    for (int k = 0; k < count; k++) {
+        TLSegment* S = &segs[s];
+        int next = S->next;
+        S->next = S->prev;
+        S->prev = next;
+        S->reversed ^= 1;
+        s = next;
+    }
+
+    segs[last].prev = before;
+    segs[g].next = after;
+    segs[before].next = last;
+    segs[after].prev = g;
+}
+
+// Reverse a..b if it lies inside one segment (returns 1), else 0
+static int try_in_segment(TwoLevelList* tl, int a, int b)
+{
+    if (tl->nodes[a].parent != tl->nodes[b].parent) return 0;
+    if (TOUR_RANK(tl, a) > TOUR_RANK(tl, b)) return 0;
+    reverse_in_segment(tl, a, b);
+    return 1;
+}
+
+void TwoLevelList_Reverse(TwoLevelList* tl, int a, int b)
+{
+    if (a == b) return;
+    int c = TwoLevelList_Next(tl, b);
+    int d = TwoLevelList_Prev(tl, a);
+    if (c == a) return;  // Whole tour: same cycle
+
+    // Short paths: one segment, the path or its complement
+    if (try_in_segment(tl, a, b) || try_in_segment(tl, c, d)) return;
+    if (tl->num_segments < 2) return;
+
+    // Cut the end segments so that a..b is a run of whole segments
+    split_before(tl, a);
+    int ga = tl->nodes[a].parent;
+    if (tl->nodes[b].parent == ga) {
+        reverse_in_segment(tl, a, b);
+        return;
+    }
+    split_after(tl, b, ga);
+    int gb = tl->nodes[b].parent;
+
+    int run = (tl->segments[gb].rank - tl->segments[ga].rank + tl->num_segments)
+            % tl->num_segments + 1;
+    if (2 * run <= tl->num_segments) {
+        reverse_segments(tl, ga, run);
+    } else if (run < tl->num_segments) {
+        reverse_segments(tl, tl->segments[gb].next, tl->num_segments - run);
+    }
+}
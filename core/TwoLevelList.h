@@ -0,0 +1,71 @@
+// core/TwoLevelList.h
+// Two-level doubly-linked list tour with O(sqrt(n)) path reversal
+//
+// The ring is cut into about sqrt(m) segments. Each segment is a doubly
+// linked list of stations with a reversal bit, and the segments form a
+// doubly linked cycle. Reversing a path:
+//   - inside one segment: relink its stations, O(segment size)
+//   - across segments: move at most half of each end segment into its
+//     neighbor so the path is made of whole segments, then flip their bits
+//     and relink them in reverse order, O(sqrt(m))
+// Paths wrap around freely; the shorter of a path and its complement is
+// reversed (same tour).
+//
+// An active_ring array reverses in O(m) per move: local search on rings of
+// thousands of stations converts the ring to a list, works on it and writes
+// it back (O(m) each way).
+//
+// Stations are 1-indexed; the list has one node per station id up to max_id.
+
+#ifndef TWO_LEVEL_LIST_H
+#define TWO_LEVEL_LIST_H
+
+#include "core\GeneType.h"
+
+typedef struct {
+    int parent;         // Segment index
+    int prev, next;     // Neighbors in the segment's own order (0: none)
+    int rank;           // Increasing along next inside the segment
+} TLNode;
+
+typedef struct {
+    int reversed;       // Tour direction runs along prev instead of next
+    int first, last;    // Ends in the segment's own order
+    int prev, next;     // Neighbor segments in tour direction
+    int rank;           // Consecutive (mod num_segments) along next
+    int size;
+} TLSegment;
+
+typedef struct TwoLevelList {
+    int max_id;
+    int size;               // Stations in the tour
+    int num_segments;
+    TLNode* nodes;          // [max_id + 1]
+    TLSegment* segments;    // [max_id]
+} TwoLevelList;
+
+// Allocate a list for station ids 1..max_id (NULL on failure)
+TwoLevelList* TwoLevelList_Create(int max_id);
+
+// Free the list (NULL is accepted)
+void TwoLevelList_Free(TwoLevelList* tl);
+
+// Load a ring (m >= 1 distinct stations), tour direction = array order
+void TwoLevelList_FromRing(TwoLevelList* tl, const gene_t* ring, int m);
+
+// Write the tour into ring (size entries), starting at station 'first'
+void TwoLevelList_ToRing(const TwoLevelList* tl, gene_t* ring, int first);
+
+// Neighbors of station s in tour direction
+int TwoLevelList_Next(const TwoLevelList* tl, int s);
+int TwoLevelList_Prev(const TwoLevelList* tl, int s);
+
+// 1 if b lies on the path from a to c in tour direction (inclusive)
+int TwoLevelList_Between(const TwoLevelList* tl, int a, int b, int c);
+
+// Reverse the path from a to b (tour direction, wrapping allowed). This is
+// the 2-opt move replacing (prev a, a) and (b, next b) by (prev a, b) and
+// (a, next b).
+void TwoLevelList_Reverse(TwoLevelList* tl, int a, int b);
+
+#endif // TWO_LEVEL_LIST_H
@@ -0,0 +1,209 @@
+// cost/BatchCost.c
+// Implementation of bit-sliced batch evaluation
+
+#include "BatchCost.h"
+#include "Cost.h"
+#include "FitnessCache.h"
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// SCRATCH
+// =============================================================================
+
+CostBatch* CostBatch_Create(int total_stations)
+{
+    if (total_stations <= 0) return NULL;
+
+    CostBatch* batch = (CostBatch*)malloc(sizeof(CostBatch));
+    if (!batch) return NULL;
+
+    batch->total_stations = total_stations;
+    batch->words = BITSET_WORDS(total_stations);
+    batch->lanes = (uint32_t*)malloc((total_stations + 1) * sizeof(uint32_t));
+    batch->lane_bits = (uint32_t*)malloc(
+        (size_t)COST_BATCH_LANES * batch->words * sizeof(uint32_t));
+
+    if (!batch->lanes || !batch->lane_bits) {
+        CostBatch_Free(batch);
+        return NULL;
+    }
+    return batch;
+}
+
+void CostBatch_Free(CostBatch* batch)
+{
+    if (!batch) return;
+    free(batch->lanes);
+    free(batch->lane_bits);
+    free(batch);
+}
+
+// =============================================================================
+// BATCH KERNEL
+// =============================================================================
+
+// Score up to COST_BATCH_LANES individuals (count <= COST_BATCH_LANES)
+static void evaluate_lanes(
+    int alpha,
+    Individual* const* inds, int count,
+    int total_stations,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    CostBatch* batch,
+    cost_t* out_costs)
+{
+    uint32_t* lanes = batch->lanes;
+    memset(lanes, 0, (total_stations + 1) * sizeof(uint32_t));
+
+    // Ring part per lane, and bit-sliced membership of every lane
+    uint32_t live = 0;
+    for (int b = 0; b < count; ++b) {
+        const Individual* ind = inds[b];
+        if (!ind || !ind->active_ring) {
+            out_costs[b] = 1e18;
+            continue;
+        }
+
+        out_costs[b] = RingCostOnly(alpha, ind->active_ring, ind->ring_size,
+                                    dist, total_stations);
+        if (ind->ring_size <= 0) continue;
+
+        uint32_t bit = 1u << b;
+        for (int k = 0; k < ind->ring_size; ++k) {
+            int id = ind->active_ring[k];
+            if (id >= 1 && id <= total_stations) lanes[id] |= bit;
+        }
+        live |= bit;
+    }
+    if (!live) return;
+
+    // Out-of-ring part: one pass over each ranking row for all lanes
+    cost_t out_sum[COST_BATCH_LANES] = { 0 };
+    uint32_t built = 0;     // Lanes whose fallback bitset is ready
+    int k = ranking->k;
+
+    for (int t = 1; t <= total_stations; ++t) {
+        uint32_t pending = live & ~lanes[t];
+        if (!pending) continue;
+
+        const rank_id_t* row = RANKING_ROW(ranking, t);
+        for (int j = 0; j < k && pending; ++j) {
+            int c = row[j];
+            uint32_t hit = pending & lanes[c];
+            if (!hit) continue;
+
+            pending &= ~hit;
+            cost_t d = DIST(dist, t - 1, c - 1);
+            do {
+                out_sum[Bitset_LowestBit(hit)] += d;
+                hit &= hit - 1;
+            } while (hit);
+        }
+
+        // Truncated ranking: the few unresolved lanes scan their own bitset
+        while (pending) {
+            int b = Bitset_LowestBit(pending);
+            uint32_t* bits = batch->lane_bits + (size_t)b * batch->words;
+            if (!(built & (1u << b))) {
+                Bitset_FromRing(bits, total_stations,
+                                inds[b]->active_ring, inds[b]->ring_size);
+                built |= 1u << b;
+            }
+
+            int nearest = Ranking_FirstActive(ranking, bits, t, 0, dist);
+            if (nearest > 0) out_sum[b] += DIST(dist, t - 1, nearest - 1);
+            pending &= pending - 1;
+        }
+    }
+
+    cost_t out_weight = 10 - alpha;
+    for (int b = 0; b < count; ++b) {
+        if (live & (1u << b)) out_costs[b] += out_weight * out_sum[b];
+    }
+}
+
+void Total_Cost_Batch(
+    int alpha,
+    Individual* const* inds, int count,
+    int total_stations,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    CostBatch* batch,
+    cost_t* out_costs)
+{
+    if (!inds || !out_costs || !batch || count <= 0) return;
+
+    for (int base = 0; base < count; base += COST_BATCH_LANES) {
+        int n = count - base;
+        if (n > COST_BATCH_LANES) n = COST_BATCH_LANES;
+        evaluate_lanes(alpha, inds + base, n, total_stations, dist, ranking,
+                       batch, out_costs + base);
+    }
+}
+
+// =============================================================================
+// SPECIES EVALUATION
+// =============================================================================
+
+int Evaluate_Specie_Batch(
+    int alpha,
+    Individual* specie, int specie_size,
+    int total_stations,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    CostBatch* batch)
+{
+    if (!specie || specie_size <= 0) return 0;
+
+    // Caller scratch if given, otherwise a temporary one
+    CostBatch* local = NULL;
+    if (!batch) {
+        local = CostBatch_Create(total_stations);
+        if (!local) return -1;
+        batch = local;
+    }
+
+    Individual* pending[COST_BATCH_LANES];
+    RingKey keys[COST_BATCH_LANES];
+    cost_t results[COST_BATCH_LANES];
+    int count = 0;
+    int use_memo = FitnessCache_Enabled();
+    int hits = 0, misses = 0;
+
+    for (int i = 0; i <= specie_size; ++i) {
+        if (i < specie_size) {
+            Individual* ind = &specie[i];
+            if (ind->cached_cost < 1e17) continue;
+
+            // Shared memo first (cost/FitnessCache.h)
+            if (use_memo && ind->active_ring) {
+                keys[count] = FitnessCache_Key(ind->active_ring, ind->ring_size);
+                if (FitnessCache_Lookup(keys[count], &ind->cached_cost)) {
+                    hits++;
+                    continue;
+                }
+                misses++;
+            }
+
+            pending[count++] = ind;
+            if (count < COST_BATCH_LANES) continue;
+        }
+        if (count == 0) break;
+
+        // Batch is full (or last partial batch)
+        evaluate_lanes(alpha, pending, count, total_stations, dist, ranking,
+                       batch, results);
+        for (int b = 0; b < count; ++b) {
+            pending[b]->cached_cost = results[b];
+            if (use_memo && pending[b]->active_ring) {
+                FitnessCache_Insert(keys[b], results[b]);
+            }
+        }
+        count = 0;
+    }
+
+    FitnessCache_Record(hits, misses);
+    CostBatch_Free(local);
+    return 0;
+}
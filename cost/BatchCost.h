@@ -0,0 +1,64 @@
+// cost/BatchCost.h
+// Batch evaluation of many individuals of a species in one call
+//
+// Up to COST_BATCH_LANES individuals are scored together. Ring membership is
+// stored bit-sliced: one word per station, bit b set if the station is in the
+// ring of lane b. The out-of-ring pass then walks each ranking row ONCE for
+// the whole batch: a single AND per candidate resolves every lane whose ring
+// contains it, and the row stops as soon as all lanes are resolved. The
+// scalar path walks the same row once per individual.
+//
+// Results are identical to Total_Cost_Individual: same raw distances, summed
+// in the same station order, weighted once.
+
+#ifndef BATCH_COST_H
+#define BATCH_COST_H
+
+#include "core\Individual.h"
+#include "utils\Distance.h"
+#include "utils\Ranking.h"
+
+// Individuals per batch (bits of a lane word)
+#define COST_BATCH_LANES 32
+
+// Per-batch scratch, reused across batches and calls
+typedef struct CostBatch {
+    int total_stations;
+    uint32_t* lanes;        // [total_stations + 1] lane word per station
+    uint32_t* lane_bits;    // [COST_BATCH_LANES * words] per-lane bitsets
+                            // (built lazily, only for truncated rankings)
+    int words;              // BITSET_WORDS(total_stations)
+} CostBatch;
+
+// Allocate scratch for instances of total_stations stations (NULL on failure)
+CostBatch* CostBatch_Create(int total_stations);
+
+// Free the scratch (NULL is accepted)
+void CostBatch_Free(CostBatch* batch);
+
+// Total cost of inds[0 .. count - 1] into out_costs[0 .. count - 1].
+// Individuals without a ring get 1e18, like Total_Cost_Individual.
+void Total_Cost_Batch(
+    int alpha,
+    Individual* const* inds, int count,
+    int total_stations,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    CostBatch* batch,
+    cost_t* out_costs
+);
+
+// Evaluate every individual of the species whose cached_cost is invalid
+// (>= 1e17), in batches, and store the result in cached_cost. Rings found in
+// the shared memo (cost/FitnessCache.h) are not evaluated again.
+// Returns 0 on success, -1 on allocation failure (costs left untouched).
+int Evaluate_Specie_Batch(
+    int alpha,
+    Individual* specie, int specie_size,
+    int total_stations,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    CostBatch* batch
+);
+
+#endif // BATCH_COST_H
@@ -4,11 +4,16 @@
 // The cost model has two components:
 // 1. Ring cost: cost of edges within the active ring
 // 2. Out-of-ring cost: cost for stations not in the ring to reach nearest ring station
+//
+// Weights (alpha, 10 - alpha) are applied once per sum, never per edge: the
+// inner loops only load and add raw distances.
 
 #ifndef COST_H
 #define COST_H
 
 #include "core\Individual.h"
+#include "utils\Ranking.h"
+#include "utils\Workspace.h"
 
 // =============================================================================
 // BASIC COST FUNCTIONS
@@ -16,11 +21,11 @@
 
 // Cost for an edge on the ring
 // Returns: alpha * distance
-double Cost_station(int alpha, double distance);
+cost_t Cost_station(int alpha, cost_t distance);
 
 // Cost for connecting an out-of-ring station to the ring
 // Returns: (10 - alpha) * distance
-double Cost_out_ring(int alpha, double distance);
+cost_t Cost_out_ring(int alpha, cost_t distance);
 
 // =============================================================================
 // RING COST CALCULATION
@@ -35,12 +40,12 @@ double Cost_out_ring(int alpha, double distance);
 //   dist        - Distance matrix (0-indexed)
 //   dist_size   - Size of distance matrix
 //
-// Returns: Sum of Cost_station for all consecutive pairs in ring
+// Returns: alpha * (sum of the consecutive edge lengths)
 //
-double RingCostOnly(
+cost_t RingCostOnly(
     int alpha,
-    const int* active_ring, int ring_size,
-    const double** dist, int dist_size
+    const gene_t* active_ring, int ring_size,
+    const DistMatrix* dist, int dist_size
 );
 
 // =============================================================================
@@ -50,7 +55,7 @@ double RingCostOnly(
 // Calculate total cost for stations not in the ring
 //
 // For each station not in the ring, finds the nearest ring station
-// and adds Cost_out_ring for that connection.
+// and adds the length of that connection.
 //
 // Parameters:
 //   alpha          - Weight for out-of-ring connections
@@ -58,14 +63,16 @@ double RingCostOnly(
 //   active_ring    - Array of station IDs in the ring (1-indexed)
 //   ring_size      - Number of stations in ring
 //   dist           - Distance matrix (0-indexed)
-//   ranking        - Sorted neighbors matrix (0-indexed)
+//   ranking        - K-nearest ranking (utils/Ranking.h)
+//   ws             - Scratch of the calling thread (NULL: temporary)
 //
-// Returns: Sum of Cost_out_ring for all non-ring stations
+// Returns: (10 - alpha) * (sum of the assignment lengths)
 //
-double OutRingCostOnly(
+cost_t OutRingCostOnly(
     int alpha, int total_stations,
-    const int* active_ring, int ring_size,
-    const double** dist, const int** ranking
+    const gene_t* active_ring, int ring_size,
+    const DistMatrix* dist, const Ranking* ranking,
+    Workspace* ws
 );
 
 // =============================================================================
@@ -75,24 +82,25 @@ double OutRingCostOnly(
 // Calculate total cost for a single individual
 // Returns: RingCostOnly + OutRingCostOnly
 //
-double Total_Cost_Individual(
+cost_t Total_Cost_Individual(
     int alpha,
     const Individual* ind,
     int total_stations,
-    const double** dist,
-    const int** ranking
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    Workspace* ws
 );
 
 // Calculate costs for all individuals in a species
 // Returns: Newly allocated array of costs (caller must free)
 //          Returns NULL on error
 //
-double* Total_Cost_Specie(
+cost_t* Total_Cost_Specie(
     int alpha,
     Individual* specie, int specie_size,
     int total_stations,
-    const double** dist,
-    const int** ranking
+    const DistMatrix* dist,
+    const Ranking* ranking
 );
 
 #endif // COST_H
@@ -0,0 +1,305 @@
+// cost/DeltaCost.c
+// Implementation of exact cost deltas for local moves
+
+#include "DeltaCost.h"
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+// Station at position k of the ring after exchanging positions a and b
+static int swapped_at(const gene_t* ring, int k, int a, int b)
+{
+    if (k == a) return ring[b];
+    if (k == b) return ring[a];
+    return ring[k];
+}
+
+// Distance from 'station' to the first ring station of its ranking row,
+// ignoring 'skip' (pass 0 to ignore nothing). Returns -1 if none is found.
+static cost_t nearest_active_dist(
+    int station, int skip,
+    const uint32_t* active_bits, const DistMatrix* dist, const Ranking* ranking)
+{
+    int nearest = Ranking_FirstActive(ranking, active_bits, station, skip, dist);
+    return (nearest > 0) ? DIST(dist, station - 1, nearest - 1) : -1;
+}
+
+// Ring part of inserting 'station' between positions pos and pos + 1
+static cost_t ring_insert_delta(
+    int alpha, const gene_t* ring, int ring_size, int pos, int station,
+    const DistMatrix* dist)
+{
+    int id_prev = ring[pos];
+    int id_next = ring[(pos + 1) % ring_size];
+    return alpha * (DIST(dist, id_prev - 1, station - 1)
+                  + DIST(dist, station - 1, id_next - 1)
+                  - DIST(dist, id_prev - 1, id_next - 1));
+}
+
+// Ring part of removing the station at position idx
+static cost_t ring_remove_delta(
+    int alpha, const gene_t* ring, int ring_size, int idx,
+    const DistMatrix* dist)
+{
+    int removed = ring[idx];
+    int id_prev = ring[(idx - 1 + ring_size) % ring_size];
+    int id_next = ring[(idx + 1) % ring_size];
+    return alpha * (DIST(dist, id_prev - 1, id_next - 1)
+                  - DIST(dist, id_prev - 1, removed - 1)
+                  - DIST(dist, removed - 1, id_next - 1));
+}
+
+// =============================================================================
+// PERMUTATION MOVES
+// =============================================================================
+
+cost_t Delta_TwoOpt(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    int i, int j,
+    const DistMatrix* dist)
+{
+    int id_a = active_ring[i];
+    int id_b = active_ring[i + 1];
+    int id_c = active_ring[j];
+    int id_d = active_ring[(j + 1) % ring_size];
+
+    cost_t d0 = DIST(dist, id_a - 1, id_b - 1) + DIST(dist, id_c - 1, id_d - 1);
+    cost_t d1 = DIST(dist, id_a - 1, id_c - 1) + DIST(dist, id_b - 1, id_d - 1);
+
+    return alpha * (d1 - d0);
+}
+
+cost_t Delta_Swap(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    int a, int b,
+    const DistMatrix* dist)
+{
+    if (a == b || ring_size <= 2) return 0;
+
+    // Edge k joins positions k and k+1. At most 4 edges are touched:
+    // (a-1, a), (a, a+1), (b-1, b), (b, b+1). Adjacent positions share one.
+    int edges[4];
+    int count = 0;
+    int candidates[4] = {
+        (a - 1 + ring_size) % ring_size, a,
+        (b - 1 + ring_size) % ring_size, b
+    };
+    for (int c = 0; c < 4; ++c) {
+        int dup = 0;
+        for (int k = 0; k < count; ++k) {
+            if (edges[k] == candidates[c]) { dup = 1; break; }
+        }
+        if (!dup) edges[count++] = candidates[c];
+    }
+
+    cost_t before = 0, after = 0;
+    for (int k = 0; k < count; ++k) {
+        int p = edges[k];
+        int q = (p + 1) % ring_size;
+        before += DIST(dist, active_ring[p] - 1, active_ring[q] - 1);
+        after += DIST(dist, swapped_at(active_ring, p, a, b) - 1,
+                            swapped_at(active_ring, q, a, b) - 1);
+    }
+
+    return alpha * (after - before);
+}
+
+cost_t Delta_Inversion(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    int a, int b,
+    const DistMatrix* dist)
+{
+    // Reversing the whole ring (or a single position) changes nothing
+    if (a >= b || (a == 0 && b == ring_size - 1)) return 0;
+
+    int id_prev = active_ring[(a - 1 + ring_size) % ring_size];
+    int id_a = active_ring[a];
+    int id_b = active_ring[b];
+    int id_next = active_ring[(b + 1) % ring_size];
+
+    // Inner edges are reversed but keep their length (symmetric distances)
+    cost_t d0 = DIST(dist, id_prev - 1, id_a - 1) + DIST(dist, id_b - 1, id_next - 1);
+    cost_t d1 = DIST(dist, id_prev - 1, id_b - 1) + DIST(dist, id_a - 1, id_next - 1);
+
+    return alpha * (d1 - d0);
+}
+
+cost_t RingPathCost(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    int from, int to,
+    const DistMatrix* dist)
+{
+    if (ring_size <= 1) return 0;
+
+    cost_t cost = 0;
+    int k = from;
+    do {
+        int next = (k + 1) % ring_size;
+        cost += DIST(dist, active_ring[k] - 1, active_ring[next] - 1);
+        k = next;
+    } while (k != to);
+
+    return alpha * cost;
+}
+
+// =============================================================================
+// MEMBERSHIP MOVES
+// =============================================================================
+
+cost_t Delta_Insert_Node(
+    int alpha, int total_stations,
+    const gene_t* active_ring, int ring_size,
+    const uint32_t* active_bits,
+    int pos, int station,
+    const DistMatrix* dist, const Ranking* ranking)
+{
+    if (ring_size <= 0) return 0;
+
+    // Ring part: edge (prev, next) becomes (prev, station) + (station, next)
+    cost_t delta = ring_insert_delta(alpha, active_ring, ring_size, pos, station, dist);
+
+    // Assignment part, in raw distance (weighted once below)
+    cost_t out_delta = 0;
+
+    // The inserted station no longer pays its assignment
+    cost_t own = nearest_active_dist(station, 0, active_bits, dist, ranking);
+    if (own >= 0) out_delta -= own;
+
+    // Other non-ring stations switch to 'station' if it is closer than their
+    // current ring station (ties leave the cost unchanged)
+    for (int t = 1; t <= total_stations; ++t) {
+        if (t == station || BITSET_TEST(active_bits, t)) continue;
+
+        int cur = Ranking_FirstActive(ranking, active_bits, t, 0, dist);
+        cost_t d_new = DIST(dist, t - 1, station - 1);
+        if (cur == 0) {
+            out_delta += d_new;
+        } else if (d_new < DIST(dist, t - 1, cur - 1)) {
+            out_delta += d_new - DIST(dist, t - 1, cur - 1);
+        }
+    }
+
+    return delta + (10 - alpha) * out_delta;
+}
+
+cost_t Delta_Remove_Node(
+    int alpha, int total_stations,
+    const gene_t* active_ring, int ring_size,
+    const uint32_t* active_bits,
+    int idx,
+    const DistMatrix* dist, const Ranking* ranking)
+{
+    if (ring_size <= 1) return 0;
+
+    // Ring part: (prev, removed) + (removed, next) becomes (prev, next)
+    int removed = active_ring[idx];
+    cost_t delta = ring_remove_delta(alpha, active_ring, ring_size, idx, dist);
+
+    // Assignment part, in raw distance (weighted once below)
+    cost_t out_delta = 0;
+
+    // The removed station is now assigned to its nearest remaining ring station
+    cost_t own = nearest_active_dist(removed, removed, active_bits, dist, ranking);
+    if (own >= 0) out_delta += own;
+
+    // Stations assigned to the removed node fall back to their next ring station
+    for (int t = 1; t <= total_stations; ++t) {
+        if (BITSET_TEST(active_bits, t)) continue;
+
+        if (Ranking_FirstActive(ranking, active_bits, t, 0, dist) != removed) continue;
+
+        cost_t fallback = nearest_active_dist(t, removed, active_bits, dist, ranking);
+        if (fallback >= 0) {
+            out_delta += fallback - DIST(dist, t - 1, removed - 1);
+        }
+    }
+
+    return delta + (10 - alpha) * out_delta;
+}
+
+cost_t Delta_Insert_Node_Cached(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    const Assignment* assign,
+    int pos, int station,
+    const DistMatrix* dist)
+{
+    if (ring_size <= 0) return 0;
+
+    return ring_insert_delta(alpha, active_ring, ring_size, pos, station, dist)
+         + (10 - alpha) * Assignment_DeltaInsert(assign, station, dist);
+}
+
+cost_t Delta_Remove_Node_Cached(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    const Assignment* assign,
+    int idx,
+    const DistMatrix* dist)
+{
+    if (ring_size <= 1) return 0;
+
+    return ring_remove_delta(alpha, active_ring, ring_size, idx, dist)
+         + (10 - alpha) * Assignment_DeltaRemove(assign, active_ring[idx], dist);
+}
+
+cost_t Delta_Replace_Node_Cached(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    const Assignment* assign,
+    int idx, int station,
+    const DistMatrix* dist)
+{
+    if (ring_size < 3) return 0;
+
+    int removed = active_ring[idx];
+    int id_prev = active_ring[(idx - 1 + ring_size) % ring_size];
+    int id_next = active_ring[(idx + 1) % ring_size];
+    cost_t delta = alpha * (DIST(dist, id_prev - 1, station - 1)
+                          + DIST(dist, station - 1, id_next - 1)
+                          - DIST(dist, id_prev - 1, removed - 1)
+                          - DIST(dist, removed - 1, id_next - 1));
+
+    // Assignment part, in raw distance (weighted once below)
+    cost_t out_delta = 0;
+    int n = assign->total_stations;
+
+    // The new ring station no longer pays its assignment
+    if (assign->nearest[station] > 0) {
+        out_delta -= DIST(dist, station - 1, assign->nearest[station] - 1);
+    }
+
+    // The removed station goes to the nearer of its nearest and the new one
+    cost_t d_own = DIST(dist, removed - 1, station - 1);
+    if (assign->nearest[removed] > 0) {
+        cost_t d_near = DIST(dist, removed - 1, assign->nearest[removed] - 1);
+        if (d_near < d_own) d_own = d_near;
+    }
+    out_delta += d_own;
+
+    for (int t = 1; t <= n; ++t) {
+        if (t == station || t == removed || BITSET_TEST(assign->in_ring, t)) continue;
+
+        int cur = assign->nearest[t];
+        if (cur == 0) continue;
+        cost_t d_cur = DIST(dist, t - 1, cur - 1);
+        cost_t d_new = DIST(dist, t - 1, station - 1);
+
+        if (cur == removed) {
+            int alt = assign->second[t];
+            if (alt > 0 && DIST(dist, t - 1, alt - 1) < d_new) {
+                d_new = DIST(dist, t - 1, alt - 1);
+            }
+            out_delta += d_new - d_cur;
+        } else if (d_new < d_cur) {
+            out_delta += d_new - d_cur;
+        }
+    }
+
+    return delta + (10 - alpha) * out_delta;
+}
@@ -0,0 +1,117 @@
+// cost/DeltaCost.h
+// Exact cost deltas for local moves on an individual
+//
+// Every Delta_* function returns (cost after move) - (cost before move) and
+// must be called BEFORE the move is applied to the ring. Adding the delta to
+// a valid cached_cost keeps it exact without a full Total_Cost_Individual.
+//
+// Permutation moves (2-opt, swap, inversion) never change ring membership, so
+// their delta only involves the few ring edges they touch: O(1).
+// Membership moves (insert, remove) also change the assignment of non-ring
+// stations; their delta scans the ranking rows with early exit.
+
+#ifndef DELTA_COST_H
+#define DELTA_COST_H
+
+#include "core\Individual.h"
+#include "core\Assignment.h"
+#include "utils\Ranking.h"
+
+// =============================================================================
+// PERMUTATION MOVES (ring edges only)
+// =============================================================================
+
+// 2-opt move: reverse segment [i+1, j] (0 <= i, i+2 <= j < ring_size)
+// Edges (i, i+1) and (j, j+1) are replaced by (i, j) and (i+1, j+1).
+cost_t Delta_TwoOpt(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    int i, int j,
+    const DistMatrix* dist
+);
+
+// Exchange the stations at positions a and b
+cost_t Delta_Swap(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    int a, int b,
+    const DistMatrix* dist
+);
+
+// Reverse the positions [a, b] (a <= b, no wrap-around)
+cost_t Delta_Inversion(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    int a, int b,
+    const DistMatrix* dist
+);
+
+// Cost of the ring edges on the path from position 'from' to position 'to'
+// (wraps around; from == to means the whole ring). Used for moves without a
+// closed-form delta (scramble): call it on the affected path before and
+// after the move.
+cost_t RingPathCost(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    int from, int to,
+    const DistMatrix* dist
+);
+
+// =============================================================================
+// MEMBERSHIP MOVES (ring edges + reassignment of non-ring stations)
+// =============================================================================
+//
+// active_bits must describe the ring BEFORE the move (utils/Bitset.h):
+//   bit id is set if station id (1-indexed) is in the ring
+//   (BITSET_WORDS(total_stations) words, see Bitset_FromRing)
+//
+
+// Insert 'station' (not in ring) between positions pos and pos + 1
+cost_t Delta_Insert_Node(
+    int alpha, int total_stations,
+    const gene_t* active_ring, int ring_size,
+    const uint32_t* active_bits,
+    int pos, int station,
+    const DistMatrix* dist, const Ranking* ranking
+);
+
+// Remove the station at position idx (ring_size must be >= 2)
+cost_t Delta_Remove_Node(
+    int alpha, int total_stations,
+    const gene_t* active_ring, int ring_size,
+    const uint32_t* active_bits,
+    int idx,
+    const DistMatrix* dist, const Ranking* ranking
+);
+
+// Same deltas using an up-to-date assignment cache (core/Assignment.h)
+// instead of ranking scans: one compare per station.
+cost_t Delta_Insert_Node_Cached(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    const Assignment* assign,
+    int pos, int station,
+    const DistMatrix* dist
+);
+
+cost_t Delta_Remove_Node_Cached(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    const Assignment* assign,
+    int idx,
+    const DistMatrix* dist
+);
+
+// Replace the station at position idx by 'station' (not in ring), same slot.
+// Exact for the combined move (not the sum of a removal and an insertion):
+// clients of the removed node fall back to the better of their
+// second-nearest and the new station. ring_size must be >= 3.
+cost_t Delta_Replace_Node_Cached(
+    int alpha,
+    const gene_t* active_ring, int ring_size,
+    const Assignment* assign,
+    int idx, int station,
+    const DistMatrix* dist
+);
+
+#endif // DELTA_COST_H
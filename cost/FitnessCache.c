@@ -0,0 +1,156 @@
+// cost/FitnessCache.c
+// Implementation of the lock-free fitness memo
+
+#include "FitnessCache.h"
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+
+typedef struct {
+    volatile uint64_t check;    // key.check ^ value
+    volatile uint64_t value;    // cost_t bits
+} CacheSlot;
+
+static CacheSlot* g_slots = NULL;
+static uint64_t g_mask = 0;
+static volatile LONG64 g_hits = 0;
+static volatile LONG64 g_misses = 0;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+// Final avalanche of MurmurHash3
+static uint64_t fmix64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static uint64_t cost_bits(cost_t cost)
+{
+    uint64_t bits;
+    memcpy(&bits, &cost, sizeof(bits));
+    return bits;
+}
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+int FitnessCache_Init(int log2_slots)
+{
+    FitnessCache_Shutdown();
+    if (log2_slots <= 0) return 0;
+    if (log2_slots > 30) log2_slots = 30;
+
+    size_t slots = (size_t)1 << log2_slots;
+    g_slots = (CacheSlot*)calloc(slots, sizeof(CacheSlot));
+    if (!g_slots) return -1;
+
+    g_mask = slots - 1;
+    g_hits = g_misses = 0;
+    return 0;
+}
+
+void FitnessCache_Shutdown(void)
+{
+    free((void*)g_slots);
+    g_slots = NULL;
+    g_mask = 0;
+}
+
+int FitnessCache_Enabled(void)
+{
+    return g_slots != NULL;
+}
+
+// =============================================================================
+// KEY
+// =============================================================================
+
+RingKey FitnessCache_Key(const gene_t* ring, int ring_size)
+{
+    RingKey key = { 0, 0 };
+    if (!ring || ring_size <= 0) return key;
+
+    // Start at the smallest id, walk towards its smaller neighbour
+    int start = 0;
+    for (int i = 1; i < ring_size; ++i) {
+        if (ring[i] < ring[start]) start = i;
+    }
+    int step = 1;
+    if (ring_size > 2) {
+        int next = ring[(start + 1) % ring_size];
+        int prev = ring[(start - 1 + ring_size) % ring_size];
+        if (prev < next) step = ring_size - 1;
+    }
+
+    // Two independent hashes: FNV-1a and a multiply-rotate accumulator
+    uint64_t h1 = 0xcbf29ce484222325ULL;
+    uint64_t h2 = (uint64_t)ring_size * 0x9e3779b97f4a7c15ULL;
+    int pos = start;
+    for (int i = 0; i < ring_size; ++i) {
+        uint64_t id = (uint64_t)(uint32_t)ring[pos];
+        h1 = (h1 ^ id) * 0x100000001b3ULL;
+        h2 = (h2 + id) * 0x9e3779b97f4a7c15ULL;
+        h2 = (h2 << 31) | (h2 >> 33);
+        pos += step;
+        if (pos >= ring_size) pos -= ring_size;
+    }
+
+    key.check = fmix64(h1 ^ (uint64_t)ring_size) | 1;  // Never matches an empty slot
+    key.index = fmix64(h2);
+    return key;
+}
+
+// =============================================================================
+// LOOKUP / INSERT
+// =============================================================================
+
+int FitnessCache_Lookup(RingKey key, cost_t* cost)
+{
+    if (!g_slots) return 0;
+
+    const CacheSlot* slot = &g_slots[key.index & g_mask];
+    uint64_t check = slot->check;
+    uint64_t value = slot->value;
+    if ((check ^ value) != key.check) return 0;
+
+    memcpy(cost, &value, sizeof(value));
+    return 1;
+}
+
+void FitnessCache_Insert(RingKey key, cost_t cost)
+{
+    if (!g_slots) return;
+
+    CacheSlot* slot = &g_slots[key.index & g_mask];
+    uint64_t value = cost_bits(cost);
+    slot->value = value;
+    slot->check = key.check ^ value;
+}
+
+// =============================================================================
+// STATISTICS
+// =============================================================================
+
+void FitnessCache_Record(int hits, int misses)
+{
+    if (!g_slots) return;
+    if (hits) InterlockedExchangeAdd64(&g_hits, hits);
+    if (misses) InterlockedExchangeAdd64(&g_misses, misses);
+}
+
+FitnessCacheStats FitnessCache_GetStats(void)
+{
+    FitnessCacheStats stats;
+    stats.hits = g_hits;
+    stats.misses = g_misses;
+    stats.slots = g_slots ? (int)(g_mask + 1) : 0;
+    return stats;
+}
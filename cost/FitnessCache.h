@@ -0,0 +1,64 @@
+// cost/FitnessCache.h
+// Process-wide fitness memo shared by all worker threads
+//
+// Species keep re-creating the same rings. Before a full evaluation, the
+// ring is looked up by a canonical key: it is read from its smallest id, in
+// the direction of the smaller neighbour, so every rotation and both
+// directions of a tour give the same key.
+//
+// The table is bounded (power of two slots, direct-mapped, always replace)
+// and lock-free: a slot is two 64-bit words {key ^ value, value}. A reader
+// accepts a slot only if the XOR matches its key, so a slot torn by a
+// concurrent writer reads as a miss instead of a wrong cost.
+//
+// One table serves one dataset and alpha (the process). In floating point
+// mode a hit may differ from a fresh evaluation by summation-order rounding
+// (same tolerance as COST_EQUAL); in COST_INTEGER mode it is exact.
+
+#ifndef FITNESS_CACHE_H
+#define FITNESS_CACHE_H
+
+#include <stdint.h>
+#include "core\CostType.h"
+#include "core\GeneType.h"
+
+// Default table size: 2^18 slots (4 MB)
+#define FITNESS_CACHE_DEFAULT_LOG2 18
+
+typedef struct RingKey {
+    uint64_t check;     // Stored (XORed) in the slot
+    uint64_t index;     // Selects the slot
+} RingKey;
+
+typedef struct FitnessCacheStats {
+    long long hits;
+    long long misses;       // Every miss is evaluated and inserted
+    int slots;
+} FitnessCacheStats;
+
+// Allocate a table of 2^log2_slots slots. log2_slots <= 0 disables the
+// cache. Returns 0 on success, -1 on allocation failure (cache disabled).
+int FitnessCache_Init(int log2_slots);
+
+// Free the table (safe if never initialized)
+void FitnessCache_Shutdown(void);
+
+// Non-zero if a table is allocated
+int FitnessCache_Enabled(void);
+
+// Rotation- and direction-invariant key of a ring
+RingKey FitnessCache_Key(const gene_t* ring, int ring_size);
+
+// Returns 1 and sets *cost on a hit, 0 on a miss
+int FitnessCache_Lookup(RingKey key, cost_t* cost);
+
+// Store the cost of a fully evaluated ring
+void FitnessCache_Insert(RingKey key, cost_t cost);
+
+// Add lookup results to the shared counters (once per batch, not per ring)
+void FitnessCache_Record(int hits, int misses);
+
+// Snapshot of the counters
+FitnessCacheStats FitnessCache_GetStats(void);
+
+#endif // FITNESS_CACHE_H
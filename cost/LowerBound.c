@@ -0,0 +1,286 @@
+// cost/LowerBound.c
+// Implementation of the Lagrangian lower bound and its refinement thread
+
+#include "LowerBound.h"
+#include <stdlib.h>
+#include <math.h>
+#include <windows.h>
+#include <process.h>
+
+// Subgradient schedule
+#define LB_LAMBDA_START     2.0     // Initial Polyak step factor
+#define LB_LAMBDA_MIN       1e-6    // Converged below this factor
+#define LB_PATIENCE         20      // Iterations without progress before halving
+#define LB_IDLE_WAIT_MS     50      // Poll interval once converged
+
+struct LowerBound {
+    int alpha;
+    int n;
+    const DistMatrix* dist;
+    const Ranking* ranking;
+
+    double* pi;             // [n + 1] node penalties
+    double* grad;           // [n + 1] subgradient
+    double* d1;             // [n + 1] distance to the nearest other station
+    double small_rings;     // Bound over rings of 1 or 2 stations
+
+    volatile double best;   // Best bound so far (published)
+    volatile double upper;  // Best known solution cost (from the caller)
+    volatile LONG iterations;
+
+    HANDLE stop_event;
+    HANDLE thread;
+};
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+// Two smallest d(v, u) + pi[u] over u != v. Uses the ranking row when it
+// provably contains them, the full row otherwise.
+static void two_smallest(
+    const LowerBound* lb, int v, double pi_min,
+    double* e1, int* u1, double* e2, int* u2)
+{
+    const Ranking* r = lb->ranking;
+    const rank_id_t* row = RANKING_ROW(r, v);
+    *e1 = *e2 = HUGE_VAL;
+    *u1 = *u2 = 0;
+
+#define CONSIDER(u) do {                                              \
+        double e = (double)DIST(lb->dist, v - 1, (u) - 1) + lb->pi[u];\
+        if (e < *e1) { *e2 = *e1; *u2 = *u1; *e1 = e; *u1 = (u); }    \
+        else if (e < *e2) { *e2 = e; *u2 = (u); }                     \
+    } while (0)
+
+    for (int j = 0; j < r->k; ++j) {
+        if (row[j] != v) CONSIDER(row[j]);
+    }
+
+    // Stations outside the row are at least as far as its last entry
+    if (r->k < lb->n) {
+        double outside = (double)DIST(lb->dist, v - 1, row[r->k - 1] - 1) + pi_min;
+        if (*e2 > outside) {
+            *e1 = *e2 = HUGE_VAL;
+            *u1 = *u2 = 0;
+            for (int u = 1; u <= lb->n; ++u) {
+                if (u != v) CONSIDER(u);
+            }
+        }
+    }
+#undef CONSIDER
+}
+
+// Bound for the current penalties; fills the subgradient
+static double evaluate(LowerBound* lb)
+{
+    int n = lb->n;
+    double alpha = lb->alpha;
+    double out_weight = 10 - lb->alpha;
+
+    double pi_min = lb->pi[1];
+    for (int v = 2; v <= n; ++v) {
+        if (lb->pi[v] < pi_min) pi_min = lb->pi[v];
+    }
+    for (int v = 1; v <= n; ++v) lb->grad[v] = 0;
+
+    double total = 0;
+    for (int v = 1; v <= n; ++v) {
+        double e1, e2;
+        int u1, u2;
+        two_smallest(lb, v, pi_min, &e1, &u1, &e2, &u2);
+
+        double ring = alpha * ((e1 + e2) / 2 - lb->pi[v]);
+        double out = out_weight * lb->d1[v];
+
+        if (v == 1 || ring <= out) {
+            total += ring;
+            lb->grad[v] -= 1.0;
+            lb->grad[u1] += 0.5;
+            lb->grad[u2] += 0.5;
+        } else {
+            total += out;
+        }
+    }
+    return total;
+}
+
+// Rings of 1 station (exact, also returned in *star_cost) and 2 stations
+// (bounded)
+static double small_ring_bound(const LowerBound* lb, double* star_cost)
+{
+    int n = lb->n;
+    double alpha = lb->alpha;
+    double out_weight = 10 - lb->alpha;
+
+    double star = 0;        // Everyone assigned to the depot
+    double sum_d1 = 0;
+    for (int v = 2; v <= n; ++v) {
+        star += (double)DIST(lb->dist, v - 1, 0);
+        sum_d1 += lb->d1[v];
+    }
+
+    *star_cost = out_weight * star;
+    double best = *star_cost;
+    for (int b = 2; b <= n; ++b) {
+        double pair = 2 * alpha * (double)DIST(lb->dist, 0, b - 1)
+                    + out_weight * (sum_d1 - lb->d1[b]);
+        if (pair < best) best = pair;
+    }
+    return best;
+}
+
+static void publish(LowerBound* lb, double value)
+{
+    if (value > lb->small_rings) value = lb->small_rings;
+    if (value > lb->best) lb->best = value;
+}
+
+// =============================================================================
+// REFINEMENT THREAD
+// =============================================================================
+
+static unsigned __stdcall bound_thread(void* arg)
+{
+    LowerBound* lb = (LowerBound*)arg;
+    int n = lb->n;
+    double lambda = LB_LAMBDA_START;
+    double best_raw = 0;
+    double used_upper = lb->upper;
+    int since_progress = 0;
+
+    for (;;) {
+        if (WaitForSingleObject(lb->stop_event, 0) == WAIT_OBJECT_0) break;
+
+        // A better solution makes the steps meaningful again
+        if (lb->upper < used_upper) {
+            used_upper = lb->upper;
+            if (lambda < LB_LAMBDA_START / 2) lambda = LB_LAMBDA_START / 2;
+        }
+
+        if (lambda < LB_LAMBDA_MIN) {
+            if (WaitForSingleObject(lb->stop_event, LB_IDLE_WAIT_MS) == WAIT_OBJECT_0) break;
+            continue;
+        }
+
+        double value = evaluate(lb);
+        InterlockedIncrement(&lb->iterations);
+
+        if (lb->iterations == 1 || value > best_raw + 1e-9 * fabs(best_raw)) {
+            best_raw = value;
+            since_progress = 0;
+            publish(lb, value);
+        } else if (++since_progress >= LB_PATIENCE) {
+            lambda /= 2;
+            since_progress = 0;
+        }
+
+        double norm = 0;
+        for (int v = 1; v <= n; ++v) norm += lb->grad[v] * lb->grad[v];
+        if (norm == 0) {
+            lambda = 0;     // Consistent degrees: the bound cannot improve
+            continue;
+        }
+
+        double gap = used_upper - value;
+        if (gap <= 0) gap = 1e-3 * fabs(used_upper) + 1e-9;
+        double step = lambda * gap / (lb->alpha * norm);
+        for (int v = 1; v <= n; ++v) lb->pi[v] += step * lb->grad[v];
+    }
+
+    return 0;
+}
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+LowerBound* LowerBound_Start(
+    int alpha, int total_stations,
+    const DistMatrix* dist, const Ranking* ranking)
+{
+    if (!dist || !ranking || total_stations < 3 || ranking->k < 2) return NULL;
+
+    LowerBound* lb = (LowerBound*)calloc(1, sizeof(LowerBound));
+    if (!lb) return NULL;
+
+    lb->alpha = alpha;
+    lb->n = total_stations;
+    lb->dist = dist;
+    lb->ranking = ranking;
+    lb->pi = (double*)calloc(total_stations + 1, sizeof(double));
+    lb->grad = (double*)calloc(total_stations + 1, sizeof(double));
+    lb->d1 = (double*)calloc(total_stations + 1, sizeof(double));
+    if (!lb->pi || !lb->grad || !lb->d1) {
+        LowerBound_Stop(lb);
+        return NULL;
+    }
+
+    // Nearest other station: first entry of the row that is not v itself
+    for (int v = 1; v <= total_stations; ++v) {
+        const rank_id_t* row = RANKING_ROW(ranking, v);
+        int u = (row[0] != v) ? row[0] : row[1];
+        lb->d1[v] = (double)DIST(dist, v - 1, u - 1);
+    }
+
+    double star_cost;
+    lb->small_rings = small_ring_bound(lb, &star_cost);
+    lb->upper = star_cost;          // Ring {1} alone is a valid solution
+    lb->best = 0;
+
+    lb->stop_event = CreateEvent(NULL, TRUE, FALSE, NULL);
+    if (!lb->stop_event) {
+        LowerBound_Stop(lb);
+        return NULL;
+    }
+    lb->thread = (HANDLE)_beginthreadex(NULL, 0, bound_thread, lb, 0, NULL);
+    if (!lb->thread) {
+        LowerBound_Stop(lb);
+        return NULL;
+    }
+    return lb;
+}
+
+double LowerBound_Get(const LowerBound* lb)
+{
+    if (!lb) return 0;
+#ifdef COST_INTEGER
+    // Integer costs: the bound rounds up
+    return ceil(lb->best - 1e-6);
+#else
+    return lb->best;
+#endif
+}
+
+int LowerBound_Iterations(const LowerBound* lb)
+{
+    return lb ? (int)lb->iterations : 0;
+}
+
+void LowerBound_SetUpperBound(LowerBound* lb, double upper)
+{
+    if (lb && upper < lb->upper) lb->upper = upper;
+}
+
+double LowerBound_Gap(const LowerBound* lb, double upper)
+{
+    double bound = LowerBound_Get(lb);
+    if (bound <= 0 || upper <= 0 || upper >= 1e17) return 1.0;
+    double gap = (upper - bound) / upper;
+    return (gap > 0) ? gap : 0;
+}
+
+void LowerBound_Stop(LowerBound* lb)
+{
+    if (!lb) return;
+    if (lb->thread) {
+        SetEvent(lb->stop_event);
+        WaitForSingleObject(lb->thread, INFINITE);
+        CloseHandle(lb->thread);
+    }
+    if (lb->stop_event) CloseHandle(lb->stop_event);
+    free(lb->pi);
+    free(lb->grad);
+    free(lb->d1);
+    free(lb);
+}
@@ -0,0 +1,52 @@
+// cost/LowerBound.h
+// Lagrangian lower bound on the ring-star cost, refined in the background
+//
+// Every station pays for itself in any solution with a ring of 3 or more:
+//   - ring station v:     alpha * (half of its two ring edges)
+//   - non-ring station v: (10 - alpha) * distance to its nearest ring station
+// Relaxing "the two edges are ring edges" to "any two other stations" and
+// "nearest ring station" to "nearest station" makes each station independent:
+//   LB = sum over v of min(alpha * (e1 + e2) / 2, (10 - alpha) * d1(v))
+// (the depot is always on the ring).
+//
+// Node penalties pi (Lagrange multipliers of the degree-2 constraint) move
+// edge lengths to d(u, v) + pi_u + pi_v without changing any ring's cost;
+// subgradient ascent on pi tightens the bound. Rings of 1 or 2 stations are
+// bounded separately and the smaller value is kept, so the result is a valid
+// bound for every solution the solver can produce.
+//
+// LowerBound_Start launches a thread that computes the bound while the
+// population is being built, then keeps refining it during the run. The
+// best known cost passed with LowerBound_SetUpperBound sets the step size.
+
+#ifndef LOWER_BOUND_H
+#define LOWER_BOUND_H
+
+#include "core\CostType.h"
+#include "utils\Distance.h"
+#include "utils\Ranking.h"
+
+typedef struct LowerBound LowerBound;
+
+// Start the bound thread. Returns NULL on failure (no bound available).
+LowerBound* LowerBound_Start(
+    int alpha, int total_stations,
+    const DistMatrix* dist, const Ranking* ranking
+);
+
+// Best bound found so far (0 until the first iteration completes)
+double LowerBound_Get(const LowerBound* lb);
+
+// Number of subgradient iterations done
+int LowerBound_Iterations(const LowerBound* lb);
+
+// Report the best known solution cost (improves the step size)
+void LowerBound_SetUpperBound(LowerBound* lb, double upper);
+
+// Relative gap (upper - bound) / upper, 1.0 if no bound is known yet
+double LowerBound_Gap(const LowerBound* lb, double upper);
+
+// Stop the thread and free everything (NULL is accepted)
+void LowerBound_Stop(LowerBound* lb);
+
+#endif // LOWER_BOUND_H
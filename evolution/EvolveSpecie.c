@@ -5,10 +5,11 @@
 
 #include "EvolveSpecie.h"
 #include "cost\Cost.h"
+#include "cost\BatchCost.h"
+#include "core\Assignment.h"
 #include "genetic\Mutation.h"
 #include "genetic\Crossover.h"
 #include "genetic\Selection.h"
-#include "local_search\TwoOpt.h"
 #include "utils\Random.h"
 
 #include <stdlib.h>
@@ -19,26 +20,59 @@
 // =============================================================================
 // SORTING HELPER
 // =============================================================================
-typedef struct {
-    double cost;
-    int index;
-} SortEntry;
-
 static int compare_by_cost(const void* a, const void* b) {
-    double diff = ((SortEntry*)a)->cost - ((SortEntry*)b)->cost;
-    if (diff < 0) return -1;
-    if (diff > 0) return 1;
+    cost_t ca = ((const SortEntry*)a)->cost;
+    cost_t cb = ((const SortEntry*)b)->cost;
+    if (ca < cb) return -1;
+    if (ca > cb) return 1;
     return 0;
 }
 
+// =============================================================================
+// EVALUATION HELPER
+// =============================================================================
+// Evaluate individuals with a stale cost, in batches when possible
+static void evaluate_stale(
+    int alpha, Individual* pop, int size, int total_stations,
+    const DistMatrix* dist, const Ranking* ranking, CostBatch* batch,
+    Workspace* ws)
+{
+    if (Evaluate_Specie_Batch(alpha, pop, size, total_stations,
+                              dist, ranking, batch) == 0) {
+        return;
+    }
+    for (int i = 0; i < size; i++) {
+        if (pop[i].cached_cost >= 1e17) {
+            pop[i].cached_cost = Total_Cost_Individual(alpha, &pop[i], total_stations, dist, ranking, ws);
+        }
+    }
+}
+
+// =============================================================================
+// ELITE POLISH HELPER
+// =============================================================================
+// FNV-1a of the ring: with the cost and size, tells whether the best elite
+// changed since it was last polished
+static uint32_t ring_hash(const Individual* ind) {
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < ind->ring_size; i++) {
+        h = (h ^ (uint32_t)ind->active_ring[i]) * 16777619u;
+    }
+    return h;
+}
+
 // =============================================================================
 // MAIN EVOLUTION FUNCTION
 // =============================================================================
 void EvolveSpecie(
     Individual* specie,
     int specie_size,
-    const double** dist,
-    const int** ranking,
+    SpeciesArena* arena,
+    Workspace* ws,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    const VndConfig* local_search,
+    const VndConfig* elite_search,
     const Node* nodes,
     int num_nodes,
     int alpha,
@@ -54,67 +88,44 @@ void EvolveSpecie(
     int enable_logs,
     int enable_timers)
 {
-    if (!specie || specie_size <= 0) return;
+    if (!specie || !arena || specie_size <= 0 || specie_size != arena->size) return;
+
+    VndConfig child_search;
+    if (!local_search) {
+        Vnd_ChildConfig(&child_search);
+        local_search = &child_search;
+    }
+    VndConfig elite_default;
+    if (!elite_search) {
+        Vnd_EliteConfig(&elite_default);
+        elite_search = &elite_default;
+    }
 
     // =========================================================================
     // STEP 1: EVALUATE ALL INDIVIDUALS
     // =========================================================================
-    double* costs = (double*)malloc(specie_size * sizeof(double));
-    if (!costs) return;
-
-    for (int i = 0; i < specie_size; i++) {
-        if (!specie[i].active_ring) {
-            Individual_Init(&specie[i], total_stations);
-        }
-        
-        if (specie[i].cached_cost < 1e17) {
-            costs[i] = specie[i].cached_cost;
-        } else {
-            costs[i] = Total_Cost_Individual(alpha, &specie[i], total_stations, dist, ranking);
-            specie[i].cached_cost = costs[i];
-        }
-    }
+    evaluate_stale(alpha, specie, specie_size, total_stations, dist, ranking, arena->batch, ws);
 
     // =========================================================================
     // STEP 2: SORT BY FITNESS
     // =========================================================================
-    SortEntry* sorted = (SortEntry*)malloc(specie_size * sizeof(SortEntry));
-    if (!sorted) {
-        free(costs);
-        return;
-    }
-
+    SortEntry* sorted = arena->sorted;
     for (int i = 0; i < specie_size; i++) {
-        sorted[i].cost = costs[i];
+        sorted[i].cost = specie[i].cached_cost;
         sorted[i].index = i;
     }
     qsort(sorted, specie_size, sizeof(SortEntry), compare_by_cost);
 
     if (enable_logs) {
         printf("[EVOLVE] Best: %.2f, Worst: %.2f\n", 
-               sorted[0].cost, sorted[specie_size-1].cost);
+               (double)sorted[0].cost, (double)sorted[specie_size-1].cost);
     }
 
     // =========================================================================
-    // STEP 3: CREATE NEW POPULATION
+    // STEP 3: NEXT POPULATION (arena slots, already allocated)
     // =========================================================================
-    Individual* new_pop = (Individual*)malloc(specie_size * sizeof(Individual));
-    if (!new_pop) {
-        free(costs);
-        free(sorted);
-        return;
-    }
-
-    for (int i = 0; i < specie_size; i++) {
-        Individual_Init(&new_pop[i], total_stations);
-    }
-
-    // Copy elites
+    Individual* new_pop = arena->next;
     int num_elites = (elitism_count < specie_size) ? elitism_count : specie_size;
-    for (int e = 0; e < num_elites; e++) {
-        Individual_Copy(&new_pop[e], &specie[sorted[e].index]);
-        new_pop[e].cached_cost = costs[sorted[e].index];
-    }
 
     // =========================================================================
     // STEP 4: GENERATE OFFSPRING
@@ -126,6 +137,10 @@ void EvolveSpecie(
     if (pool_size < 2) pool_size = 2;
     if (pool_size > specie_size) pool_size = specie_size;
 
+    // Parent whose ring ws->parent_assign describes (-1: none yet)
+    int assign_parent = -1;
+    memset(arena->mutated_from, 0, specie_size * sizeof(int));
+
     for (int i = 0; i < num_offspring; i++) {
         // Select parents from mating pool
         int p1_idx = sorted[RandInt(0, pool_size - 1)].index;
@@ -135,17 +150,18 @@ void EvolveSpecie(
         Individual* child = &new_pop[num_elites + i];
 
         // ----- CROSSOVER -----
-        int child_size = 0;
-        int* child_ring = Slice_Crossover(
+        Individual_ClearPositions(child);  // Slot is about to be overwritten
+        child->ring_size = 0;
+        int child_size = Slice_Crossover(
             parent1->active_ring, parent1->ring_size,
             parent2->active_ring, parent2->ring_size,
-            &child_size, total_stations  // FIX: was 50, now total_stations
+            child->active_ring, child->ring_capacity, ws
         );
 
-        if (child_ring && child_size > 0) {
-            memcpy(child->active_ring, child_ring, child_size * sizeof(int));
+        if (child_size > 0) {
             child->ring_size = child_size;
-            free(child_ring);
+            child->cached_cost = 1e18;  // New ring: needs a full evaluation
+            Individual_SyncPositions(child, 0, child_size - 1);
         } else {
             Individual_Copy(child, parent1);
         }
@@ -155,43 +171,72 @@ void EvolveSpecie(
         int identical = 0;
         if (child->ring_size == parent1->ring_size && child->ring_size > 0) {
             if (memcmp(child->active_ring, parent1->active_ring, 
-                       child->ring_size * sizeof(int)) == 0) {
+                       child->ring_size * sizeof(gene_t)) == 0) {
                 identical = 1;
+                // Same ring as parent1: reuse its cost, mutations update it by delta
+                child->cached_cost = parent1->cached_cost;
             }
         }
 
         if (identical || RandDouble() < mutation_rate) {
-            Individual mutated;
-            Individual_Init(&mutated, total_stations);  // FIX: was 50, now total_stations
-            Mutations(&mutated, add_pct, remove_pct, swap_pct, inv_pct, scr_pct,
-                     child, total_stations, dist);
-            Individual_Copy(child, &mutated);
-            Individual_Free(&mutated);
+            // Only an identical child has a cost to update. From the second
+            // one of a parent on, its add/remove deltas use parent1's
+            // assignment cache (a build costs about four uncached mutations,
+            // most parents give a single identical child)
+            const Assignment* source = NULL;
+            if (identical && ws && child->cached_cost < 1e17 &&
+                (add_pct > 0 || remove_pct > 0)) {
+                if (assign_parent != p1_idx && arena->mutated_from[p1_idx] > 0) {
+                    Assignment_Build(ws->parent_assign, parent1->active_ring,
+                                     parent1->ring_size, dist, ranking);
+                    assign_parent = p1_idx;
+                }
+                if (assign_parent == p1_idx) source = ws->parent_assign;
+                arena->mutated_from[p1_idx]++;
+            }
+
+            // Mutate into the scratch slot, then trade slots with the child
+            Mutations(&arena->scratch, add_pct, remove_pct, swap_pct, inv_pct, scr_pct,
+                     child, source, alpha, total_stations, dist, ranking, ws);
+            SpeciesArena_Exchange(child, &arena->scratch);
         }
 
-        // ----- 2-OPT LOCAL SEARCH -----
+        // ----- LOCAL SEARCH (VND, default 2-opt then Or-opt) -----
         if (child->ring_size >= 3) {
-            TwoOptImproveAlpha(child, alpha, dist, ranking);
+            Vnd_Run(child, alpha, total_stations, dist, ranking, local_search, ws);
         }
 
-        // ----- EVALUATE -----
-        child->cached_cost = Total_Cost_Individual(alpha, child, total_stations, dist, ranking);
     }
 
+    // ----- EVALUATE -----
+    // Only children whose cost could not be tracked by delta (crossover),
+    // all scored together in batches
+    evaluate_stale(alpha, new_pop + num_elites, num_offspring, total_stations,
+                   dist, ranking, arena->batch, ws);
+
     // =========================================================================
     // STEP 5: REPLACE OLD POPULATION
     // =========================================================================
-    for (int i = 0; i < specie_size; i++) {
-        Individual_Free(&specie[i]);
-        specie[i] = new_pop[i];
+    // Elites trade slots with their (discarded) parent copy: no ring copy
+    for (int e = 0; e < num_elites; e++) {
+        SpeciesArena_Exchange(&new_pop[e], &specie[sorted[e].index]);
     }
-
-    // =========================================================================
-    // CLEANUP
-    // =========================================================================
-    free(costs);
-    free(sorted);
-    free(new_pop);
+    // Membership hill climbing then variable-depth search (elite_search) on
+    // the best elite, only when it changed since its last polish: the scans
+    // of an unchanged elite find nothing and cost a full pass on large
+    // instances (on every elite it took a quarter of the generations)
+    if (num_elites > 0) {
+        Individual* elite = &new_pop[0];
+        if (elite->ring_size != arena->polished_size ||
+            !COST_EQUAL(elite->cached_cost, arena->polished_cost) ||
+            ring_hash(elite) != arena->polished_hash) {
+            Vnd_Run(elite, alpha, total_stations, dist, ranking, elite_search, ws);
+            arena->polished_cost = elite->cached_cost;
+            arena->polished_size = elite->ring_size;
+            arena->polished_hash = ring_hash(elite);
+        }
+    }
+    SpeciesArena_Swap(arena, specie);
 }
 
 void EvolveSpecie_Sanity(Individual* specie) {
@@ -2,7 +2,8 @@
 // Header for genetic evolution operators
 //
 // Usage:
-//   EvolveSpecie(specie, size, dist, ranking, nodes, num_nodes,
+//   EvolveSpecie(specie, size, arena, ws, dist, ranking, local_search, elite_search,
+//                nodes, num_nodes,
 //                alpha, total_stations, mutation_rate, elitism,
 //                add%, remove%, swap%, inv%, scramble%,
 //                mating_pool_fraction, enable_logs, enable_timers);
@@ -12,14 +13,24 @@
 
 #include "core\Individual.h"
 #include "core\Node.h"
+#include "utils\Ranking.h"
+#include "evolution\SpeciesArena.h"
+#include "utils\Workspace.h"
+#include "local_search\Vnd.h"
 
 // Evolve a species for one generation
 // 
 // Parameters:
 //   specie              - Array of individuals (modified in place)
 //   specie_size         - Number of individuals
+//   arena               - Storage of this species (SpeciesArena_Create on
+//                         specie); next generation and per-species scratch
+//   ws                  - Scratch arrays of the calling thread (NULL: temporary)
 //   dist                - Distance matrix [i][j] = distance between i and j
-//   ranking             - Sorted neighbors [i][k] = k-th nearest to i
+//   ranking             - K-nearest ranking (utils/Ranking.h)
+//   local_search        - Descent applied to each child (NULL: Vnd_ChildConfig)
+//   elite_search        - Descent applied to the best elite when it changed
+//                         (NULL: Vnd_EliteConfig)
 //   nodes               - Node coordinates (unused, kept for compatibility)
 //   num_nodes           - Number of nodes (unused)
 //   alpha               - Cost weighting parameter
@@ -38,8 +49,12 @@
 
 void EvolveSpecie(
     Individual* specie, int specie_size,
-    const double** dist,
-    const int** ranking,
+    SpeciesArena* arena,
+    Workspace* ws,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    const VndConfig* local_search,
+    const VndConfig* elite_search,
     const Node* nodes, int num_nodes,
     int alpha,
     int total_stations,
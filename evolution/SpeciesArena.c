@@ -0,0 +1,136 @@
+// evolution/SpeciesArena.c
+// Implementation of the double-buffered species storage
+
+#include "SpeciesArena.h"
+#include "core\Assignment.h"
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+SpeciesArena* SpeciesArena_Create(Individual* specie, int size, int total_stations)
+{
+    if (!specie || size <= 0 || total_stations <= 0) return NULL;
+
+    SpeciesArena* arena = (SpeciesArena*)calloc(1, sizeof(SpeciesArena));
+    if (!arena) return NULL;
+
+    arena->size = size;
+    arena->stride = total_stations;
+    arena->slots = (gene_t*)malloc((size_t)(2 * size + 1) * total_stations * sizeof(gene_t));
+    arena->positions = (gene_t*)malloc((size_t)(2 * size + 1) * (total_stations + 1) * sizeof(gene_t));
+    arena->next = (Individual*)calloc(size, sizeof(Individual));
+    arena->sorted = (SortEntry*)malloc(size * sizeof(SortEntry));
+    arena->mutated_from = (int*)calloc(size, sizeof(int));
+    arena->tabu_until = (int*)calloc(total_stations + 1, sizeof(int));
+    if (!arena->slots || !arena->positions || !arena->next || !arena->sorted ||
+        !arena->mutated_from || !arena->tabu_until) {
+        free(arena->slots);
+        free(arena->positions);
+        free(arena->next);
+        free(arena->sorted);
+        free(arena->mutated_from);
+        free(arena->tabu_until);
+        free(arena);
+        return NULL;
+    }
+    arena->batch = CostBatch_Create(total_stations);  // Optional
+
+    // Slots [0, size): live generation, moved from the heap buffers
+    for (int i = 0; i < size; i++) {
+        Individual* ind = &specie[i];
+        gene_t* slot = arena->slots + (size_t)i * total_stations;
+
+        if (ind->active_ring) {
+            if (ind->ring_size > total_stations) ind->ring_size = total_stations;
+            memcpy(slot, ind->active_ring, ind->ring_size * sizeof(gene_t));
+            free(ind->active_ring);
+        } else {
+            ind->ring_size = 0;
+            ind->cached_cost = 1e18;
+        }
+        ind->active_ring = slot;
+        ind->ring_capacity = total_stations;
+        free(ind->position);
+        ind->position = NULL;
+        Individual_AttachPositions(ind, arena->positions + (size_t)i * (total_stations + 1));
+    }
+
+    // Slots [size, 2 * size): next generation, then the scratch slot
+    for (int i = 0; i < size; i++) {
+        Individual* ind = &arena->next[i];
+        ind->active_ring = arena->slots + (size_t)(size + i) * total_stations;
+        ind->ring_capacity = total_stations;
+        ind->cached_cost = 1e18;
+        Individual_AttachPositions(ind, arena->positions + (size_t)(size + i) * (total_stations + 1));
+    }
+    arena->scratch.active_ring = arena->slots + (size_t)(2 * size) * total_stations;
+    arena->scratch.ring_capacity = total_stations;
+    arena->scratch.cached_cost = 1e18;
+    Individual_AttachPositions(&arena->scratch, arena->positions + (size_t)(2 * size) * (total_stations + 1));
+
+    return arena;
+}
+
+void SpeciesArena_Free(SpeciesArena* arena, Individual* specie)
+{
+    if (!arena) return;
+
+    if (specie) {
+        for (int i = 0; i < arena->size; i++) {
+            specie[i].active_ring = NULL;
+            specie[i].position = NULL;
+            specie[i].ring_size = 0;
+            specie[i].ring_capacity = 0;
+        }
+    }
+    for (int i = 0; i < arena->size; i++) {
+        Assignment_Destroy(arena->next[i].assign);
+    }
+    Assignment_Destroy(arena->scratch.assign);
+
+    CostBatch_Free(arena->batch);
+    free(arena->slots);
+    free(arena->positions);
+    free(arena->next);
+    free(arena->sorted);
+    free(arena->mutated_from);
+    free(arena->tabu_until);
+    free(arena);
+}
+
+// =============================================================================
+// GENERATION SWAP
+// =============================================================================
+
+void SpeciesArena_Exchange(Individual* a, Individual* b)
+{
+    Individual tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+void SpeciesArena_Swap(SpeciesArena* arena, Individual* specie)
+{
+    for (int i = 0; i < arena->size; i++) {
+        SpeciesArena_Exchange(&specie[i], &arena->next[i]);
+    }
+}
+
+size_t SpeciesArena_Bytes(const SpeciesArena* arena)
+{
+    if (!arena) return 0;
+    size_t bytes = sizeof(SpeciesArena)
+                 + (size_t)(2 * arena->size + 1) * arena->stride * sizeof(gene_t)
+                 + (size_t)(2 * arena->size + 1) * (arena->stride + 1) * sizeof(gene_t)
+                 + (size_t)arena->size * (sizeof(Individual) + sizeof(SortEntry) + sizeof(int))
+                 + (size_t)(arena->stride + 1) * sizeof(int);
+    if (arena->batch) {
+        bytes += sizeof(CostBatch)
+               + (size_t)(arena->stride + 1) * sizeof(uint32_t)
+               + (size_t)arena->batch->words * COST_BATCH_LANES * sizeof(uint32_t);
+    }
+    return bytes;
+}
@@ -0,0 +1,78 @@
+// evolution/SpeciesArena.h
+// Preallocated, double-buffered storage for one species
+//
+// All ring buffers of a species live in one block of fixed-stride slots:
+// one per individual of the live generation (the caller's Individual array),
+// one per individual of the next generation (built by EvolveSpecie) and one
+// mutation scratch slot. A generation ends by swapping the two header
+// arrays, so ring data never moves; elites are carried over by exchanging
+// slots with the discarded parent they came from.
+//
+// Every header (live, next, scratch) also gets a position index from one
+// more block, so the operators can answer membership, successor and
+// predecessor queries in O(1) on any ring of the species.
+//
+// The arena also holds the per-generation scratch (sort keys, batch lanes)
+// and the state the trajectory engines keep from one generation to the next,
+// so a generation does no allocation in steady state and the footprint of a
+// species is fixed at creation.
+//
+// Usage:
+//   SpeciesArena* arena = SpeciesArena_Create(specie, pop_size, total_stations);
+//   EvolveSpecie(specie, pop_size, arena, ...);   // each generation
+//   SpeciesArena_Free(arena, specie);             // before Free_Population
+
+#ifndef SPECIES_ARENA_H
+#define SPECIES_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "core\Individual.h"
+#include "cost\BatchCost.h"
+
+typedef struct {
+    cost_t cost;
+    int index;
+} SortEntry;
+
+typedef struct SpeciesArena {
+    int size;               // Individuals per generation
+    int stride;             // Ring slot capacity (total stations)
+    gene_t* slots;          // (2 * size + 1) * stride ring slots, one block
+    gene_t* positions;      // (2 * size + 1) * (stride + 1) position indexes
+    Individual* next;       // [size] generation being built
+    Individual scratch;     // Mutation output (last slot)
+    SortEntry* sorted;      // [size] costs of the live generation, sorted
+    int* mutated_from;      // [size] identical children mutated per parent
+    CostBatch* batch;       // Batch evaluation lanes (NULL: scalar path)
+
+    // Best elite after its last polish (EvolveSpecie): skipped while unchanged
+    cost_t polished_cost;
+    int polished_size;      // 0: never polished
+    uint32_t polished_hash;
+
+    // State of the trajectory engines across generations (evolution/Trajectory.h)
+    double temperature;     // Annealing temperature (0: chain not started)
+    double start_temperature;
+    int iteration;          // Tabu search iterations so far
+    int* tabu_until;        // [stride + 1] iteration a station stays tabu until
+} SpeciesArena;
+
+// Move the rings of specie[0..size-1] into a new arena (their heap buffers
+// are released). Returns NULL on failure, specie is then left unchanged.
+SpeciesArena* SpeciesArena_Create(Individual* specie, int size, int total_stations);
+
+// Release the arena. The rings of specie point into it: they are detached
+// (active_ring = position = NULL), the headers can then go to Free_Population.
+void SpeciesArena_Free(SpeciesArena* arena, Individual* specie);
+
+// Exchange two individuals (headers only, each keeps owning one slot)
+void SpeciesArena_Exchange(Individual* a, Individual* b);
+
+// End of generation: arena->next becomes the live generation in specie
+void SpeciesArena_Swap(SpeciesArena* arena, Individual* specie);
+
+// Bytes held by the arena
+size_t SpeciesArena_Bytes(const SpeciesArena* arena);
+
+#endif // SPECIES_ARENA_H
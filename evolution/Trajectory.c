@@ -0,0 +1,448 @@
+// evolution/Trajectory.c
+// Implementation of the simulated annealing and tabu search engines
+
+#include "Trajectory.h"
+#include "core\Assignment.h"
+#include "cost\Cost.h"
+#include "cost\DeltaCost.h"
+#include "local_search\TwoOpt.h"
+#include "local_search\MaskLocalSearch.h"
+#include "utils\Random.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// ENGINE SELECTION
+// =============================================================================
+
+static const struct {
+    const char* name;
+    SpecieEngine engine;
+} ENGINE_NAMES[] = {
+    { "ga",   ENGINE_GENETIC },
+    { "sa",   ENGINE_ANNEALING },
+    { "tabu", ENGINE_TABU }
+};
+
+#define NUM_ENGINE_NAMES (int)(sizeof(ENGINE_NAMES) / sizeof(ENGINE_NAMES[0]))
+
+void Engine_DefaultConfig(EngineConfig* config)
+{
+    config->count = 1;
+    config->list[0] = ENGINE_GENETIC;
+}
+
+int Engine_ParseList(EngineConfig* config, const char* list)
+{
+    if (!config || !list) return 0;
+
+    SpecieEngine parsed[ENGINE_MAX_LIST];
+    int count = 0;
+    const char* p = list;
+
+    while (*p) {
+        size_t len = strcspn(p, ",");
+        int found = -1;
+        for (int k = 0; k < NUM_ENGINE_NAMES; k++) {
+            if (strlen(ENGINE_NAMES[k].name) == len &&
+                strncmp(p, ENGINE_NAMES[k].name, len) == 0) {
+                found = k;
+                break;
+            }
+        }
+        if (found < 0 || count == ENGINE_MAX_LIST) return 0;
+        parsed[count++] = ENGINE_NAMES[found].engine;
+
+        p += len;
+        if (*p == ',') p++;
+    }
+    if (count == 0) return 0;
+
+    config->count = count;
+    for (int k = 0; k < count; k++) config->list[k] = parsed[k];
+    return 1;
+}
+
+const char* Engine_Name(SpecieEngine engine)
+{
+    for (int k = 0; k < NUM_ENGINE_NAMES; k++) {
+        if (ENGINE_NAMES[k].engine == engine) return ENGINE_NAMES[k].name;
+    }
+    return "?";
+}
+
+// =============================================================================
+// MOVES
+// =============================================================================
+
+typedef enum {
+    MOVE_TWO_OPT,       // Reverse slots [i + 1, j]
+    MOVE_DROP,          // Remove slot i
+    MOVE_ADD,           // Insert station after slot i
+    MOVE_SWAP           // Put station in slot i
+} MoveKind;
+
+typedef struct {
+    MoveKind kind;
+    int i, j;
+    int station;
+    int keys[2];        // Stations the move is about (tabu attributes, 0: none)
+    cost_t delta;
+} Move;
+
+// Share of membership moves (drop, add, swap in equal parts)
+#define MEMBERSHIP_RATE 0.2
+
+// Draw a random move around a ring station and one of its ranking
+// candidates. Returns 0 when the draw gives no valid move.
+static int sample_move(const Individual* ind, int alpha, const DistMatrix* dist,
+                       const Ranking* ranking, Move* move)
+{
+    int m = ind->ring_size;
+    const gene_t* ring = ind->active_ring;
+    int i = RandInt(0, m - 1);
+    int a = ring[i];
+    int c = RANKING_ROW(ranking, a)[RandInt(0, ranking->k - 1)];
+    if (c == a) return 0;
+
+    double r = RandDouble();
+    if (r >= MEMBERSHIP_RATE) {
+        // 2-opt creating the edge (a, c)
+        if (!RING_CONTAINS(ind, c)) return 0;
+        int j = ind->position[c];
+        if (i > j) { int t = i; i = j; j = t; }
+        if (j - i < 2 || (i == 0 && j == m - 1)) return 0;
+        move->kind = MOVE_TWO_OPT;
+        move->i = i;
+        move->j = j;
+        move->keys[0] = a;
+        move->keys[1] = c;
+        move->delta = Delta_TwoOpt(alpha, ring, m, i, j, dist);
+        return 1;
+    }
+
+    if (r < MEMBERSHIP_RATE / 3) {
+        if (a == 1 || m <= 3) return 0;  // Depot stays
+        move->kind = MOVE_DROP;
+        move->i = i;
+        move->keys[0] = a;
+        move->keys[1] = 0;
+        move->delta = Delta_Remove_Node_Cached(alpha, ring, m, ind->assign, i, dist);
+        return 1;
+    }
+
+    if (RING_CONTAINS(ind, c)) return 0;
+
+    if (r < 2 * MEMBERSHIP_RATE / 3) {
+        if (m >= ind->ring_capacity) return 0;
+        // Cheaper side of a
+        int prev = (i - 1 + m) % m;
+        int p = ring[prev];
+        int n = ring[(i + 1) % m];
+        cost_t before = (cost_t)DIST(dist, p - 1, c - 1) + DIST(dist, c - 1, a - 1)
+                      - DIST(dist, p - 1, a - 1);
+        cost_t after = (cost_t)DIST(dist, a - 1, c - 1) + DIST(dist, c - 1, n - 1)
+                     - DIST(dist, a - 1, n - 1);
+        move->kind = MOVE_ADD;
+        move->i = (before < after) ? prev : i;
+        move->station = c;
+        move->keys[0] = c;
+        move->keys[1] = 0;
+        move->delta = Delta_Insert_Node_Cached(alpha, ring, m, ind->assign, move->i, c, dist);
+        return 1;
+    }
+
+    if (a == 1) return 0;
+    move->kind = MOVE_SWAP;
+    move->i = i;
+    move->station = c;
+    move->keys[0] = a;
+    move->keys[1] = c;
+    move->delta = Delta_Replace_Node_Cached(alpha, ring, m, ind->assign, i, c, dist);
+    return 1;
+}
+
+static void apply_move(Individual* ind, const Move* move,
+                       const DistMatrix* dist, const Ranking* ranking)
+{
+    if (ind->cached_cost < 1e17) {
+        ind->cached_cost += move->delta;
+    }
+    switch (move->kind) {
+    case MOVE_TWO_OPT:
+        TwoOptReverse(ind, move->i + 1, move->j);
+        break;
+    case MOVE_DROP:
+        MaskRemoveAt(ind, move->i, dist, ranking);
+        break;
+    case MOVE_ADD:
+        MaskInsertAfter(ind, move->i, move->station, dist);
+        break;
+    case MOVE_SWAP:
+        MaskReplaceAt(ind, move->i, move->station, dist, ranking);
+        break;
+    }
+}
+
+// =============================================================================
+// TRAJECTORY STATE
+// =============================================================================
+
+// Copy the current ring into best, without the assignment cache it borrows
+static void save_best(Individual* best, Individual* current)
+{
+    struct Assignment* assign = current->assign;
+    current->assign = NULL;
+    Individual_Copy(best, current);
+    current->assign = assign;
+}
+
+// Go back to the best ring, its assignment cache rebuilt in the one current uses
+static void load_best(Individual* current, const Individual* best,
+                      const DistMatrix* dist, const Ranking* ranking)
+{
+    struct Assignment* assign = current->assign;
+    current->assign = NULL;
+    Individual_Copy(current, best);
+    current->assign = assign;
+    Assignment_Build(assign, current->active_ring, current->ring_size, dist, ranking);
+}
+
+// Start of a call: score stale rings, on a restart make the best one the
+// current solution, give it the workspace assignment cache if it has none
+// (returns 1 if it was borrowed) and remember it as the best of the call
+// (arena->scratch)
+static int begin_call(Individual* specie, int specie_size, SpeciesArena* arena,
+                       Workspace* ws, const DistMatrix* dist, const Ranking* ranking,
+                       int alpha, int total_stations, int restart)
+{
+    int best = 0;
+    for (int i = 0; i < specie_size; i++) {
+        if (specie[i].cached_cost >= 1e17) {
+            specie[i].cached_cost = Total_Cost_Individual(alpha, &specie[i], total_stations,
+                                                          dist, ranking, ws);
+        }
+        if (specie[i].cached_cost < specie[best].cached_cost) best = i;
+    }
+    if (restart && best != 0) {
+        SpeciesArena_Exchange(&specie[0], &specie[best]);
+    }
+
+    Individual* current = &specie[0];
+    int borrowed = (current->assign == NULL);
+    if (borrowed) {
+        Assignment_Build(ws->assign, current->active_ring, current->ring_size, dist, ranking);
+        current->assign = ws->assign;
+    }
+    save_best(&arena->scratch, current);
+    return borrowed;
+}
+
+// End of a call: exact costs again (thousands of deltas add up rounding),
+// then the best ring of the call takes the place of the worst kept one
+// unless the species already holds that cost. Returns the best cost.
+static cost_t end_call(Individual* specie, int specie_size, SpeciesArena* arena,
+                       Workspace* ws, const DistMatrix* dist, const Ranking* ranking,
+                       int alpha, int total_stations, int borrowed)
+{
+    Individual* current = &specie[0];
+    Individual* best = &arena->scratch;
+    if (borrowed) current->assign = NULL;
+    current->cached_cost = Total_Cost_Individual(alpha, current, total_stations, dist, ranking, ws);
+    best->cached_cost = Total_Cost_Individual(alpha, best, total_stations, dist, ranking, ws);
+    cost_t best_cost = best->cached_cost;
+    if (specie_size < 2) return best_cost;
+
+    int worst = 1;
+    for (int i = 1; i < specie_size; i++) {
+        if (COST_EQUAL(specie[i].cached_cost, best_cost)) return best_cost;
+        if (specie[i].cached_cost > specie[worst].cached_cost) worst = i;
+    }
+    if (COST_IMPROVES(best_cost, specie[worst].cached_cost)) {
+        SpeciesArena_Exchange(&specie[worst], best);
+    }
+    return best_cost;
+}
+
+// =============================================================================
+// SIMULATED ANNEALING
+// =============================================================================
+
+// Uphill moves sampled to set the start temperature
+#define ANNEAL_SAMPLES 101
+
+static int compare_double(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Temperature at which the uphill move at the 10th percentile is accepted
+// with probability ANNEAL_START_ACCEPT (most random moves are far uphill,
+// starting from the mean or the median wrecks the ring)
+static double start_temperature(const Individual* ind, int alpha,
+                                const DistMatrix* dist, const Ranking* ranking)
+{
+    double uphill[ANNEAL_SAMPLES];
+    int count = 0;
+    for (int t = 0; t < 20 * ANNEAL_SAMPLES && count < ANNEAL_SAMPLES; t++) {
+        Move move;
+        if (sample_move(ind, alpha, dist, ranking, &move) && move.delta > 0) {
+            uphill[count++] = (double)move.delta;
+        }
+    }
+    if (count == 0) return 1.0;
+    qsort(uphill, count, sizeof(double), compare_double);
+    return uphill[count / 10] / -log(ANNEAL_START_ACCEPT);
+}
+
+void AnnealSpecie(
+    Individual* specie, int specie_size,
+    SpeciesArena* arena,
+    Workspace* ws,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    int alpha,
+    int total_stations,
+    int enable_logs)
+{
+    if (!specie || !arena || !dist || !ranking || specie_size <= 0) return;
+
+    Workspace* temp = ws ? NULL : Workspace_Create(total_stations);
+    if (!ws) ws = temp;
+    if (!ws) return;
+
+    int restart = (arena->temperature <= 0 || specie[0].cached_cost >= 1e17);
+    int borrowed = begin_call(specie, specie_size, arena, ws, dist, ranking,
+                              alpha, total_stations, restart);
+    Individual* current = &specie[0];
+    Individual* best = &arena->scratch;
+
+    if (restart) {
+        arena->start_temperature = start_temperature(current, alpha, dist, ranking);
+        arena->temperature = arena->start_temperature;
+    }
+    double temperature = arena->temperature;
+
+    int moves = ANNEAL_MOVES_PER_INDIVIDUAL * specie_size;
+    for (int t = 0; t < moves; t++) {
+        if (current->ring_size < 3) break;
+        Move move;
+        if (!sample_move(current, alpha, dist, ranking, &move)) continue;
+
+        if (move.delta > 0 && RandDouble() >= exp(-(double)move.delta / temperature)) continue;
+
+        apply_move(current, &move, dist, ranking);
+        if (COST_IMPROVES(current->cached_cost, best->cached_cost)) {
+            save_best(best, current);
+        }
+    }
+
+    cost_t best_cost = end_call(specie, specie_size, arena, ws, dist, ranking,
+                                alpha, total_stations, borrowed);
+
+    if (enable_logs) {
+        printf("[ANNEAL] T: %.3g, Current: %.2f, Best of call: %.2f\n",
+               temperature, (double)current->cached_cost, (double)best_cost);
+    }
+
+    // Cool down, reheat once frozen
+    arena->temperature *= ANNEAL_COOLING;
+    if (arena->temperature < ANNEAL_FROZEN * arena->start_temperature) {
+        arena->temperature = arena->start_temperature;
+    }
+    Workspace_Free(temp);
+}
+
+// =============================================================================
+// TABU SEARCH
+// =============================================================================
+
+static int is_tabu(const SpeciesArena* arena, const Move* move)
+{
+    for (int k = 0; k < 2; k++) {
+        if (move->keys[k] && arena->tabu_until[move->keys[k]] > arena->iteration) return 1;
+    }
+    return 0;
+}
+
+void TabuSpecie(
+    Individual* specie, int specie_size,
+    SpeciesArena* arena,
+    Workspace* ws,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    int alpha,
+    int total_stations,
+    int enable_logs)
+{
+    if (!specie || !arena || !dist || !ranking || specie_size <= 0) return;
+
+    Workspace* temp = ws ? NULL : Workspace_Create(total_stations);
+    if (!ws) ws = temp;
+    if (!ws) return;
+
+    int restart = (arena->iteration == 0 || specie[0].cached_cost >= 1e17);
+    int borrowed = begin_call(specie, specie_size, arena, ws, dist, ranking,
+                              alpha, total_stations, restart);
+    Individual* current = &specie[0];
+    Individual* best = &arena->scratch;
+
+    if (restart) {
+        memset(arena->tabu_until, 0, (arena->stride + 1) * sizeof(int));
+        arena->iteration = 1;
+    }
+
+    int iterations = TABU_ITERATIONS_PER_INDIVIDUAL * specie_size;
+    int stall = 0;
+    for (int t = 0; t < iterations; t++) {
+        if (current->ring_size < 3) break;
+
+        // Uphill moves with no new best: the chain drifts away, go back
+        if (stall == TABU_STALL) {
+            load_best(current, best, dist, ranking);
+            stall = 0;
+        }
+
+        // Best admissible candidate, uphill if need be; a tabu move is
+        // admissible when it gives a new best (aspiration)
+        Move chosen;
+        int found = 0;
+        for (int k = 0; k < TABU_CANDIDATES; k++) {
+            Move move;
+            if (!sample_move(current, alpha, dist, ranking, &move)) continue;
+            if (found && move.delta >= chosen.delta) continue;
+            if (is_tabu(arena, &move) &&
+                !COST_IMPROVES(current->cached_cost + move.delta, best->cached_cost)) continue;
+            chosen = move;
+            found = 1;
+        }
+        arena->iteration++;
+        if (!found) continue;
+
+        apply_move(current, &chosen, dist, ranking);
+        int tenure = TABU_TENURE + RandInt(0, TABU_TENURE);
+        for (int k = 0; k < 2; k++) {
+            if (chosen.keys[k]) arena->tabu_until[chosen.keys[k]] = arena->iteration + tenure;
+        }
+        if (COST_IMPROVES(current->cached_cost, best->cached_cost)) {
+            save_best(best, current);
+            stall = 0;
+        } else {
+            stall++;
+        }
+    }
+
+    cost_t best_cost = end_call(specie, specie_size, arena, ws, dist, ranking,
+                                alpha, total_stations, borrowed);
+
+    if (enable_logs) {
+        printf("[TABU] Iteration: %d, Current: %.2f, Best of call: %.2f\n",
+               arena->iteration, (double)current->cached_cost, (double)best_cost);
+    }
+    Workspace_Free(temp);
+}
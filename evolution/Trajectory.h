@@ -0,0 +1,100 @@
+// evolution/Trajectory.h
+// Single-solution engines for a species: simulated annealing and tabu search
+//
+// Instead of a generation of the GA (evolution/EvolveSpecie.h), a species
+// can run one trajectory: specie[0] is its current solution and the other
+// individuals keep the best solutions it has visited. Each call (one
+// generation) makes a fixed number of moves from the current solution and,
+// at the end, the best ring of the call replaces the worst kept one. The
+// state carried between calls (temperature, tabu list) lives in the
+// species arena; a species reset (stale specie[0]) restarts it.
+//
+// Moves, all with exact O(1) or assignment-cache deltas (cost/DeltaCost.h):
+//   - 2-opt joining a random ring station to one of its ranking candidates
+//   - drop a ring station (never the depot)
+//   - add an off-ring candidate next to a ring station
+//   - swap a ring station with one of its off-ring candidates
+//
+// Annealing: one random move at a time, accepted with probability
+// exp(-delta / T). T starts from the uphill moves around the current
+// solution, cools after each call and is reset when frozen.
+//
+// Tabu search: the best of TABU_CANDIDATES random moves, even uphill, but
+// not one touching a station moved in the last few iterations (unless it
+// gives a new best). After TABU_STALL iterations without a new best the
+// search goes back to the best ring of the call.
+
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include "core\Individual.h"
+#include "utils\Ranking.h"
+#include "evolution\SpeciesArena.h"
+#include "utils\Workspace.h"
+
+typedef enum {
+    ENGINE_GENETIC,
+    ENGINE_ANNEALING,
+    ENGINE_TABU
+} SpecieEngine;
+
+// Engines given to the species in turn (species s runs list[s % count])
+#define ENGINE_MAX_LIST 8
+
+typedef struct {
+    int count;
+    SpecieEngine list[ENGINE_MAX_LIST];
+} EngineConfig;
+
+// Moves per individual of the species in one call
+#define ANNEAL_MOVES_PER_INDIVIDUAL 50
+#define TABU_ITERATIONS_PER_INDIVIDUAL 2
+
+// Acceptance of a small uphill move (10th percentile) at the start temperature,
+// temperature factor after each call, and the fraction of the start
+// temperature under which the chain is reheated
+#define ANNEAL_START_ACCEPT 0.1
+#define ANNEAL_COOLING 0.9
+#define ANNEAL_FROZEN 1e-3
+
+// Random moves compared per tabu iteration, shortest tabu tenure, and
+// iterations without a new best before going back to the best ring
+#define TABU_CANDIDATES 32
+#define TABU_TENURE 10
+#define TABU_STALL 20
+
+// Default: every species runs the GA
+void Engine_DefaultConfig(EngineConfig* config);
+
+// Replace the list with comma separated names among "ga", "sa", "tabu",
+// e.g. "ga,sa". Returns 0 (config unchanged) on an unknown or empty list.
+int Engine_ParseList(EngineConfig* config, const char* list);
+
+// Name of an engine for the logs
+const char* Engine_Name(SpecieEngine engine);
+
+// One call of each engine, same inputs as EvolveSpecie (ws: NULL for a
+// temporary workspace)
+void AnnealSpecie(
+    Individual* specie, int specie_size,
+    SpeciesArena* arena,
+    Workspace* ws,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    int alpha,
+    int total_stations,
+    int enable_logs
+);
+
+void TabuSpecie(
+    Individual* specie, int specie_size,
+    SpeciesArena* arena,
+    Workspace* ws,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    int alpha,
+    int total_stations,
+    int enable_logs
+);
+
+#endif // TRAJECTORY_H
@@ -5,8 +5,10 @@
 //
 #include "PopulationInit.h"
 #include "utils\Random.h"
-#include "local_search\TwoOpt.h"
+#include "utils\ThreadPool.h"
+#include "local_search\Partition.h"
 #include <stdlib.h>
+#include <time.h>
 
 Individual** Random_Generation(const Node* node_vector, int num_nodes,
                               int species_number, int individual_number,
@@ -81,22 +83,90 @@ Individual** Random_Generation(const Node* node_vector, int num_nodes,
 //
 // fraction : proportion d'espces  optimiser (ex: 0.2 = 20% = 1/5)
 // ============================================================================
+// Une descente par individu slectionn, sur les workers du pool
+typedef struct {
+    Individual** targets;
+    int alpha;
+    const DistMatrix* dist;
+    const Ranking* ranking;
+    const VndConfig* config;
+    clock_t deadline;   // Fin de la phase (0 : aucune)
+} InitSearchJob;
+
+static void init_search_job(void* context, int index, Workspace* ws)
+{
+    InitSearchJob* job = (InitSearchJob*)context;
+    VndConfig config = *job->config;
+    if (job->deadline) {
+        clock_t left = job->deadline - clock();
+        if (left <= 0) return;  // Budget puis
+        config.max_ms = (int)((double)left * 1000.0 / CLOCKS_PER_SEC) + 1;  // Reste de la phase
+    }
+    Vnd_Run(job->targets[index], job->alpha, job->ranking->total_stations,
+            job->dist, job->ranking, &config, ws);
+}
+
 void Apply_TwoOpt_To_Population(Individual** species, int num_species, int pop_size,
-                                 int alpha, const double** dist, const int** ranking)
+                                 int alpha, const DistMatrix* dist, const Ranking* ranking,
+                                 const VndConfig* local_search, int budget_ms)
 {
     // Appliquer 2-Opt EXHAUSTIF sur 20% des espces (1 espce sur 5)
     int optimize_every = 5;  // 1 sur 5 = 20%
-    
-    for (int s = 0; s < num_species; ++s) {
-        if (s % optimize_every == 0) {
-            for (int i = 0; i < pop_size; ++i) {
-                if (species[s][i].ring_size >= 3) {
-                    // Utiliser 2-Opt EXHAUSTIF pour l'initialisation
-                    TwoOptExhaustive(&species[s][i], alpha, dist, ranking);
-                }
+    if (!ranking) return;
+    VndConfig init_search;
+    if (!local_search) {
+        Vnd_InitConfig(&init_search);
+        local_search = &init_search;
+    }
+
+    Individual** targets = (Individual**)malloc((size_t)num_species * pop_size * sizeof(Individual*));
+    Workspace* ws = Workspace_Create(ranking->total_stations);
+    if (!targets || !ws) {
+        free(targets);
+        Workspace_Free(ws);
+        return;
+    }
+
+    int count = 0;
+    for (int s = 0; s < num_species; s += optimize_every) {
+        for (int i = 0; i < pop_size; ++i) {
+            if (species[s][i].ring_size >= 3) targets[count++] = &species[s][i];
+        }
+    }
+
+    // Budget de la phase (dcoupage compris) : chaque individu descend
+    // jusqu' convergence ou jusqu' la fin de la phase, ceux pas encore
+    // commencs sont sauts
+    clock_t deadline = 0;
+    if (local_search->max_ms == 0 && budget_ms > 0) {
+        deadline = clock() + (clock_t)((double)budget_ms * CLOCKS_PER_SEC / 1000.0);
+    }
+
+    // Grands rings : tranches en parallle puis rparation des frontires,
+    // pour qu'un seul individu ne bloque pas l'initialisation. Seulement
+    // s'il y en a moins que de workers : sinon ils les occupent dj tous
+    int large = 0;
+    for (int t = 0; t < count; ++t) {
+        if (targets[t]->ring_size >= PARTITION_MIN_RING) large++;
+    }
+    if (large > 0 && large < ThreadPool_NumWorkers()) {
+        for (int t = 0; t < count; ++t) {
+            if (targets[t]->ring_size >= PARTITION_MIN_RING) {
+                PartitionedLocalSearch(targets[t], alpha, dist, ranking, ws, deadline);
             }
         }
     }
+
+    // VND exhaustive pour l'initialisation : un individu par job
+    InitSearchJob job = { targets, alpha, dist, ranking, local_search, deadline };
+    if (ThreadPool_NumWorkers() > 0) {
+        ThreadPool_RunJobs(init_search_job, &job, count);
+    } else {
+        for (int t = 0; t < count; ++t) init_search_job(&job, t, ws);
+    }
+
+    Workspace_Free(ws);
+    free(targets);
 }
 
 void Free_Population(Individual** species, int num_species, int ind_per_species)
@@ -3,6 +3,8 @@
 
 #include "core\Node.h"
 #include "core\Individual.h"
+#include "utils\Ranking.h"
+#include "local_search\Vnd.h"
 
 // Allocates 2D array of individuals (species x individuals)
 // Returns array of pointers to species arrays
@@ -12,10 +14,18 @@ Individual** Random_Generation(
     int individual_number,
     int* out_species_count);
 
-// Apply 2-Opt to all individuals in the population (like reference code)
-// This should be called right after Random_Generation for better initial quality
+// Apply the local search descent to every fifth species (NULL config:
+// Vnd_InitConfig). This should be called right after Random_Generation for
+// better initial quality. With a thread pool running (ThreadPool_Init), the
+// individuals are spread over the workers; when fewer rings of
+// PARTITION_MIN_RING stations or more than workers are selected, each of
+// them is first split across the workers (local_search/Partition.h).
+// budget_ms: time for the whole phase, splitting included, when the config
+// has no max_ms (0: no limit). Each individual descends until convergence or
+// the end of the phase; those not started by then are left as they are.
 void Apply_TwoOpt_To_Population(Individual** species, int num_species, int pop_size,
-                                 int alpha, const double** dist, const int** ranking);
+                                 int alpha, const DistMatrix* dist, const Ranking* ranking,
+                                 const VndConfig* local_search, int budget_ms);
 
 // Free population
 void Free_Population(Individual** species, int num_species, int ind_per_species);
@@ -1,46 +1,35 @@
-// genetic/Crossover.c - Optimized with stack allocation
+// genetic/Crossover.c - Scratch from the thread workspace, no allocation
 //
 // IMPORTANT: Le nud 1 (dpt) doit TOUJOURS tre prsent dans l'enfant !
 //
 #include "Crossover.h"
 #include "utils\Random.h"
-#include "utils\StackConfig.h"
+#include "utils\Bitset.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
-int* Slice_Crossover(const int* parentA, int sizeA,
-                     const int* parentB, int sizeB,
-                     int* child_size, int max_capacity)
+int Slice_Crossover(const gene_t* parentA, int sizeA,
+                    const gene_t* parentB, int sizeB,
+                    gene_t* child, int max_capacity,
+                    Workspace* ws)
 {
     int m = (sizeA < sizeB) ? sizeA : sizeB;
-    if (m == 0) return NULL;
-    
-    int* child = (int*)malloc(max_capacity * sizeof(int));
-    if (!child) return NULL;
+    if (m == 0 || max_capacity <= 0) return 0;
     
     // Find max ID
     int max_id = 0;
     for (int i = 0; i < sizeA; ++i) if (parentA[i] > max_id) max_id = parentA[i];
     for (int i = 0; i < sizeB; ++i) if (parentB[i] > max_id) max_id = parentB[i];
     
-    if (max_id <= 0) {
-        free(child);
-        return NULL;
-    }
-    
-    // Use stack for small arrays
-    int stack_used[MAX_STACK_BUFFER_SIZE];
-    int* used;
-    int use_heap = (max_id + 1 > MAX_STACK_BUFFER_SIZE);
+    if (max_id <= 0) return 0;
     
-    if (use_heap) {
-        used = (int*)calloc(max_id + 1, sizeof(int));
-        if (!used) { free(child); return NULL; }
-    } else {
-        used = stack_used;
-        memset(used, 0, (max_id + 1) * sizeof(int));
-    }
+    // Packed "already in child" set, in the workspace
+    Workspace* temp = (ws && ws->total_stations >= max_id) ? NULL : Workspace_Create(max_id);
+    if (temp) ws = temp;
+    if (!ws || ws->total_stations < max_id) return 0;
+    uint32_t* used = ws->bits;
+    Bitset_Clear(used, max_id);
     
     // Random cut points
     int cut1 = RandInt(0, m - 1);
@@ -52,19 +41,19 @@ int* Slice_Crossover(const int* parentA, int sizeA,
     for (int i = cut1; i <= cut2 && i < sizeA && child_idx < max_capacity; ++i) {
         child[child_idx++] = parentA[i];
         if (parentA[i] > 0 && parentA[i] <= max_id)
-            used[parentA[i]] = 1;
+            BITSET_SET(used, parentA[i]);
     }
     
     // Fill from parent B
     for (int i = 0; i < sizeB && child_idx < max_capacity; ++i) {
-        if (parentB[i] > 0 && parentB[i] <= max_id && !used[parentB[i]]) {
+        if (parentB[i] > 0 && parentB[i] <= max_id && !BITSET_TEST(used, parentB[i])) {
             child[child_idx++] = parentB[i];
-            used[parentB[i]] = 1;
+            BITSET_SET(used, parentB[i]);
         }
     }
     
     // SCURIT : S'assurer que le dpt (nud 1) est dans l'enfant
-    if (!used[1] && child_idx < max_capacity) {
+    if (!BITSET_TEST(used, 1) && child_idx < max_capacity) {
         // Insrer le dpt au dbut
         for (int i = child_idx; i > 0; i--) {
             child[i] = child[i - 1];
@@ -73,7 +62,6 @@ int* Slice_Crossover(const int* parentA, int sizeA,
         child_idx++;
     }
     
-    *child_size = child_idx;
-    if (use_heap) free(used);
-    return child;
+    Workspace_Free(temp);
+    return child_idx;
 }
@@ -2,11 +2,17 @@
 #ifndef CROSSOVER_H
 #define CROSSOVER_H
 
+#include "core\GeneType.h"
+#include "utils\Workspace.h"
+
 // Slice crossover: take a slice from parent A, fill rest from parent B
-// Returns child ring (caller must free)
-int* Slice_Crossover(
-    const int* parentA, int sizeA,
-    const int* parentB, int sizeB,
-    int* child_size, int max_capacity);
+// The child is written into a caller buffer of max_capacity ids
+// ws: scratch of the calling thread (NULL: temporary)
+// Returns the child size (0 if no child could be built)
+int Slice_Crossover(
+    const gene_t* parentA, int sizeA,
+    const gene_t* parentB, int sizeB,
+    gene_t* child, int max_capacity,
+    Workspace* ws);
 
 #endif
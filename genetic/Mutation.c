@@ -1,55 +1,40 @@
-// genetic/Mutation.c - Optimized with stack allocation
+// genetic/Mutation.c - Scratch from the thread workspace, no allocation
 //
 // IMPORTANT: Le nud 1 (dpt) ne doit JAMAIS tre supprim du ring !
 //
 #include "Mutation.h"
+#include "cost\DeltaCost.h"
 #include "utils\Random.h"
-#include "utils\StackConfig.h"
+#include "utils\Bitset.h"
 #include <stdlib.h>
 #include <string.h>
 
-void Mutation_Add_Node(Individual* ind, int total_stations, const double** dist)
+void Mutation_Add_Node(Individual* ind, int alpha, int total_stations,
+                       const DistMatrix* dist, const Ranking* ranking,
+                       Workspace* ws)
 {
     if (!ind || !dist || total_stations <= 0) return;
     
-    // Use stack for small arrays
-    int stack_active[MAX_STACK_BUFFER_SIZE];
-    int stack_inactive[MAX_STACK_BUFFER_SIZE];
-    int* is_active;
-    int* inactive;
-    int use_heap = (total_stations + 1 > MAX_STACK_BUFFER_SIZE);
-    
-    if (use_heap) {
-        is_active = (int*)calloc(total_stations + 1, sizeof(int));
-        inactive = (int*)malloc(total_stations * sizeof(int));
-        if (!is_active || !inactive) {
-            if (is_active) free(is_active);
-            if (inactive) free(inactive);
-            return;
-        }
-    } else {
-        is_active = stack_active;
-        inactive = stack_inactive;
-        memset(is_active, 0, (total_stations + 1) * sizeof(int));
-    }
+    // Membership bitset and inactive list live in the workspace
+    Workspace* temp = ws ? NULL : Workspace_Create(total_stations);
+    if (!ws) ws = temp;
+    if (!ws) return;
+    uint32_t* active_bits = ws->bits;
+    int* inactive = ws->ids;
     
     // Mark active stations
-    for (int i = 0; i < ind->ring_size; ++i) {
-        int id = ind->active_ring[i];
-        if (id > 0 && id <= total_stations)
-            is_active[id] = 1;
-    }
+    Bitset_FromRing(active_bits, total_stations, ind->active_ring, ind->ring_size);
     
     // Find inactive stations
     int inactive_count = 0;
     for (int s = 1; s <= total_stations; ++s) {
-        if (!is_active[s]) {
+        if (!BITSET_TEST(active_bits, s)) {
             inactive[inactive_count++] = s;
         }
     }
     
     if (inactive_count == 0) {
-        if (use_heap) { free(is_active); free(inactive); }
+        Workspace_Free(temp);
         return;
     }
     
@@ -59,24 +44,27 @@ void Mutation_Add_Node(Individual* ind, int total_stations, const double** dist)
         if (ind->ring_capacity > 0) {
             ind->active_ring[0] = station_to_add;
             ind->ring_size = 1;
+            ind->cached_cost = 1e18;
+            Individual_SyncPositions(ind, 0, 0);
+            if (ind->assign) Assignment_Insert(ind->assign, station_to_add, dist);
         }
-        if (use_heap) { free(is_active); free(inactive); }
+        Workspace_Free(temp);
         return;
     }
     
     // Find best insertion position
     int best_pos = 0;
-    double best_cost = 1e18;
+    cost_t best_cost = 1e18;
     
     for (int pos = 0; pos < ind->ring_size; ++pos) {
         int id_prev = ind->active_ring[pos];
         int id_next = ind->active_ring[(pos + 1) % ind->ring_size];
         
         if (id_prev > 0 && id_next > 0 && id_prev <= total_stations && id_next <= total_stations) {
-            double old_dist = dist[id_prev - 1][id_next - 1];
-            double new_dist = dist[id_prev - 1][station_to_add - 1]
-                            + dist[station_to_add - 1][id_next - 1];
-            double cost_delta = new_dist - old_dist;
+            cost_t old_dist = DIST(dist, id_prev - 1, id_next - 1);
+            cost_t new_dist = DIST(dist, id_prev - 1, station_to_add - 1)
+                            + DIST(dist, station_to_add - 1, id_next - 1);
+            cost_t cost_delta = new_dist - old_dist;
             
             if (cost_delta < best_cost) {
                 best_cost = cost_delta;
@@ -87,17 +75,35 @@ void Mutation_Add_Node(Individual* ind, int total_stations, const double** dist)
     
     // Insert station
     if (ind->ring_size < ind->ring_capacity) {
+        // Keep the cached cost valid (delta must be computed before the move)
+        if (ind->cached_cost < 1e17) {
+            if (ind->assign) {
+                ind->cached_cost += Delta_Insert_Node_Cached(
+                    alpha, ind->active_ring, ind->ring_size, ind->assign,
+                    best_pos, station_to_add, dist);
+            } else {
+                ind->cached_cost += Delta_Insert_Node(
+                    alpha, total_stations,
+                    ind->active_ring, ind->ring_size, active_bits,
+                    best_pos, station_to_add, dist, ranking);
+            }
+        }
         for (int i = ind->ring_size; i > best_pos + 1; --i) {
             ind->active_ring[i] = ind->active_ring[i - 1];
         }
         ind->active_ring[best_pos + 1] = station_to_add;
         ind->ring_size++;
+        Individual_SyncPositions(ind, best_pos + 1, ind->ring_size - 1);
+        if (ind->assign) Assignment_Insert(ind->assign, station_to_add, dist);
     }
     
-    if (use_heap) { free(is_active); free(inactive); }
+    Workspace_Free(temp);
 }
 
-void Mutation_Remove_Node(Individual* ind, int min_ring_size)
+void Mutation_Remove_Node(Individual* ind, int min_ring_size,
+                          int alpha, int total_stations,
+                          const DistMatrix* dist, const Ranking* ranking,
+                          Workspace* ws)
 {
     if (!ind || ind->ring_size <= min_ring_size) return;
     
@@ -113,13 +119,40 @@ void Mutation_Remove_Node(Individual* ind, int min_ring_size)
         if (attempts > 10) return;
     } while (ind->active_ring[idx] == 1);
     
+    // Keep the cached cost valid (delta must be computed before the move)
+    if (ind->cached_cost < 1e17 && ind->assign) {
+        ind->cached_cost += Delta_Remove_Node_Cached(
+            alpha, ind->active_ring, ind->ring_size, ind->assign, idx, dist);
+    } else if (ind->cached_cost < 1e17) {
+        Workspace* temp = ws ? NULL : Workspace_Create(total_stations);
+        Workspace* scratch = ws ? ws : temp;
+        
+        if (scratch) {
+            uint32_t* active_bits = scratch->bits;
+            Bitset_FromRing(active_bits, total_stations, ind->active_ring, ind->ring_size);
+            ind->cached_cost += Delta_Remove_Node(
+                alpha, total_stations,
+                ind->active_ring, ind->ring_size, active_bits,
+                idx, dist, ranking);
+            Workspace_Free(temp);
+        } else {
+            ind->cached_cost = 1e18;
+        }
+    }
+    
+    int removed = ind->active_ring[idx];
     for (int i = idx; i < ind->ring_size - 1; ++i) {
         ind->active_ring[i] = ind->active_ring[i + 1];
     }
     ind->ring_size--;
+    if (ind->position) {
+        ind->position[removed] = RING_POS_NONE;
+        Individual_SyncPositions(ind, idx, ind->ring_size - 1);
+    }
+    if (ind->assign) Assignment_Remove(ind->assign, removed, dist, ranking);
 }
 
-void Mutation_Swap_Simple(Individual* ind)
+void Mutation_Swap_Simple(Individual* ind, int alpha, const DistMatrix* dist)
 {
     if (!ind || ind->ring_size < 2) return;
     
@@ -128,12 +161,20 @@ void Mutation_Swap_Simple(Individual* ind)
     int a = RandInt(0, ind->ring_size - 1);
     int b = RandInt(0, ind->ring_size - 1);
     
+    if (ind->cached_cost < 1e17) {
+        ind->cached_cost += Delta_Swap(alpha, ind->active_ring, ind->ring_size, a, b, dist);
+    }
+    
     int tmp = ind->active_ring[a];
     ind->active_ring[a] = ind->active_ring[b];
     ind->active_ring[b] = tmp;
+    if (ind->position) {
+        ind->position[ind->active_ring[a]] = (gene_t)a;
+        ind->position[ind->active_ring[b]] = (gene_t)b;
+    }
 }
 
-void Mutation_Inversion(Individual* ind)
+void Mutation_Inversion(Individual* ind, int alpha, const DistMatrix* dist)
 {
     if (!ind || ind->ring_size < 2) return;
     
@@ -141,58 +182,95 @@ void Mutation_Inversion(Individual* ind)
     int b = RandInt(0, ind->ring_size - 1);
     if (a > b) { int tmp = a; a = b; b = tmp; }
     
+    if (ind->cached_cost < 1e17) {
+        ind->cached_cost += Delta_Inversion(alpha, ind->active_ring, ind->ring_size, a, b, dist);
+    }
+    
+    int lo = a, hi = b;
     while (a < b) {
         int tmp = ind->active_ring[a];
         ind->active_ring[a] = ind->active_ring[b];
         ind->active_ring[b] = tmp;
         a++; b--;
     }
+    Individual_SyncPositions(ind, lo, hi);
 }
 
-void Mutation_Scramble(Individual* ind)
+void Mutation_Scramble(Individual* ind, int alpha, const DistMatrix* dist)
 {
     if (!ind || ind->ring_size < 2) return;
     
-    int a = RandInt(0, ind->ring_size - 1);
-    int b = RandInt(0, ind->ring_size - 1);
+    int m = ind->ring_size;
+    int a = RandInt(0, m - 1);
+    int b = RandInt(0, m - 1);
     if (a > b) { int tmp = a; a = b; b = tmp; }
     
+    // Affected edges: path from a-1 to b+1 (whole ring if the window covers it)
+    int track = (ind->cached_cost < 1e17);
+    int from = 0, to = 0;
+    if (b - a + 2 < m) {
+        from = (a - 1 + m) % m;
+        to = (b + 1) % m;
+    }
+    cost_t before = track ? RingPathCost(alpha, ind->active_ring, m, from, to, dist) : 0;
+    
     for (int i = a; i <= b; ++i) {
         int j = RandInt(a, b);
         int tmp = ind->active_ring[i];
         ind->active_ring[i] = ind->active_ring[j];
         ind->active_ring[j] = tmp;
     }
+    Individual_SyncPositions(ind, a, b);
+    
+    if (track) {
+        ind->cached_cost += RingPathCost(alpha, ind->active_ring, m, from, to, dist) - before;
+    }
 }
 
 void Mutations(Individual* out_individual,
                int add_percentage, int remove_percentage, int swap_percentage,
                int inversion_percentage, int scramble_percentage,
-               const Individual* individual, int total_stations, const double** dist)
+               const Individual* individual,
+               const struct Assignment* source_assign,
+               int alpha, int total_stations,
+               const DistMatrix* dist, const Ranking* ranking,
+               Workspace* ws)
 {
     if (!out_individual || !individual) return;
     
     Individual_Copy(out_individual, individual);
     
-    if (RandInt(1, 100) <= add_percentage) {
-        Mutation_Add_Node(out_individual, total_stations, dist);
+    int do_add = (RandInt(1, 100) <= add_percentage);
+    int do_remove = (RandInt(1, 100) <= remove_percentage);
+    
+    // Membership deltas from a copy of the source cache (O(N) memcpy)
+    int borrowed = 0;
+    if ((do_add || do_remove) && source_assign && ws && !out_individual->assign &&
+        out_individual->cached_cost < 1e17) {
+        Assignment_Copy(ws->assign, source_assign);
+        out_individual->assign = ws->assign;
+        borrowed = 1;
+    }
+    
+    if (do_add) {
+        Mutation_Add_Node(out_individual, alpha, total_stations, dist, ranking, ws);
     }
-    if (RandInt(1, 100) <= remove_percentage) {
-        Mutation_Remove_Node(out_individual, 3);
+    if (do_remove) {
+        Mutation_Remove_Node(out_individual, 3, alpha, total_stations, dist, ranking, ws);
     }
     if (RandInt(1, 100) <= swap_percentage) {
-        Mutation_Swap_Simple(out_individual);
+        Mutation_Swap_Simple(out_individual, alpha, dist);
     }
     if (RandInt(1, 100) <= inversion_percentage) {
-        Mutation_Inversion(out_individual);
+        Mutation_Inversion(out_individual, alpha, dist);
     }
     if (RandInt(1, 100) <= scramble_percentage) {
-        Mutation_Scramble(out_individual);
+        Mutation_Scramble(out_individual, alpha, dist);
     }
     
     // SCURIT : S'assurer que le dpt (nud 1) est dans le ring
-    int has_depot = 0;
-    for (int i = 0; i < out_individual->ring_size; i++) {
+    int has_depot = out_individual->position ? RING_CONTAINS(out_individual, 1) : 0;
+    for (int i = 0; !out_individual->position && i < out_individual->ring_size; i++) {
         if (out_individual->active_ring[i] == 1) {
             has_depot = 1;
             break;
@@ -205,7 +283,10 @@ void Mutations(Individual* out_individual,
         }
         out_individual->active_ring[0] = 1;
         out_individual->ring_size++;
+        out_individual->cached_cost = 1e18;
+        Individual_SyncPositions(out_individual, 0, out_individual->ring_size - 1);
+        if (out_individual->assign) Assignment_Insert(out_individual->assign, 1, dist);
     }
     
-    out_individual->cached_cost = 1e18;
+    if (borrowed) out_individual->assign = NULL;
 }
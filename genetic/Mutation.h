@@ -4,22 +4,44 @@
 
 #include "core\Individual.h"
 #include "core\Node.h"
+#include "utils\Ranking.h"
+#include "utils\Workspace.h"
+
+// Every mutation keeps ind->cached_cost valid through an exact delta
+// (see cost/DeltaCost.h). An invalid cost (>= 1e17) is left untouched.
+// If ind->assign is attached, add/remove use it for the delta and keep it
+// up to date. ws is the scratch of the calling thread (NULL: temporary).
 
 // Add a random inactive station at the best insertion position
 void Mutation_Add_Node(
     Individual* ind,
+    int alpha,
     int total_stations,
-    const double** dist);
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    Workspace* ws);
 
 // Remove a random station from the ring (keeping at least 3)
-void Mutation_Remove_Node(Individual* ind, int min_ring_size);
+void Mutation_Remove_Node(
+    Individual* ind,
+    int min_ring_size,
+    int alpha,
+    int total_stations,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    Workspace* ws);
 
 // Permutation mutations
-void Mutation_Swap_Simple(Individual* ind);
-void Mutation_Inversion(Individual* ind);
-void Mutation_Scramble(Individual* ind);
+void Mutation_Swap_Simple(Individual* ind, int alpha, const DistMatrix* dist);
+void Mutation_Inversion(Individual* ind, int alpha, const DistMatrix* dist);
+void Mutation_Scramble(Individual* ind, int alpha, const DistMatrix* dist);
 
 // All mutations bundled together
+// out_individual inherits the cost of individual, updated move by move.
+// source_assign: assignment cache of individual's ring, or NULL. When given
+// (with ws), add/remove work on a copy of it in ws->assign: their deltas
+// cost O(N) compares instead of a ranking scan per non-ring station (the
+// uncached path, still O(N) scans).
 void Mutations(
     Individual* out_individual,
     int add_percentage,
@@ -28,8 +50,12 @@ void Mutations(
     int inversion_percentage,
     int scramble_percentage,
     const Individual* individual,
+    const struct Assignment* source_assign,
+    int alpha,
     int total_stations,
-    const double** dist);
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    Workspace* ws);
 
 #endif
 
@@ -2,7 +2,9 @@
 #ifndef SELECTION_H
 #define SELECTION_H
 
+#include "core\CostType.h"
+
 // Find index of best (minimum) cost
-int Select_Best(const double* costs, int size);
+int Select_Best(const cost_t* costs, int size);
 
 #endif
@@ -0,0 +1,178 @@
+// local_search/LinKernighan.c
+// Implementation of the variable-depth ring optimizer
+
+#include "LinKernighan.h"
+#include "local_search\TwoOpt.h"
+#include "NeighborSearch.h"
+#include "utils\Bitset.h"
+
+// Ring neighbors in the current orientation (dir 1: array order reversed)
+#define SUCC(ind, s, dir) ((dir) ? RING_PREV(ind, s) : RING_NEXT(ind, s))
+#define PRED(ind, s, dir) ((dir) ? RING_NEXT(ind, s) : RING_PREV(ind, s))
+
+// =============================================================================
+// ONE MOVE
+// =============================================================================
+
+// Best chain from t1, first with t2 = next t1, then with t2 = prev t1.
+// Applies it and returns the number of stations whose edges changed (written
+// to touched, t1 first), or 0 if no chain improves the ring.
+static int lk_move(Individual* ind, int t1, const DistMatrix* dist,
+                   const Ranking* ranking, int alpha, int* touched)
+{
+    int undo_i[LK_MAX_DEPTH], undo_j[LK_MAX_DEPTH];
+    int added_a[LK_MAX_DEPTH], added_b[LK_MAX_DEPTH];
+    int nodes[2 * LK_MAX_DEPTH];
+
+    for (int dir0 = 0; dir0 < 2; dir0++) {
+        int dir = dir0;
+        int t2 = SUCC(ind, t1, dir);
+        cost_t removed = DIST(dist, t1 - 1, t2 - 1);
+        cost_t added = 0;
+        cost_t best_gain = 0;
+        int best_depth = 0;
+        int depth = 0;
+
+        while (depth < LK_MAX_DEPTH) {
+            // Next step: t3 among the candidates of t2, the one whose broken
+            // edge (t4, t3) is the longest relative to the new edge (t2, t3)
+            const rank_id_t* row = RANKING_ROW(ranking, t2);
+            int t3 = 0, t4 = 0;
+            cost_t best_score = 0;
+            int succ2 = SUCC(ind, t2, dir);
+
+            for (int r = 0; r < ranking->k; r++) {
+                int c = row[r];
+                if (c == t2 || !RING_CONTAINS(ind, c)) continue;
+
+                dist_t d23 = DIST(dist, t2 - 1, c - 1);
+                if (!COST_IMPROVES(added + d23, removed)) break;  // Gain criterion
+                if (c == t1 || c == succ2) continue;
+
+                int d = PRED(ind, c, dir);
+                int tabu = 0;
+                for (int k = 0; k < depth && !tabu; k++) {
+                    tabu = (added_a[k] == d && added_b[k] == c)
+                        || (added_a[k] == c && added_b[k] == d);
+                }
+                if (tabu) continue;
+
+                cost_t score = (cost_t)DIST(dist, d - 1, c - 1) - d23;
+                if (!t3 || score > best_score) {
+                    t3 = c;
+                    t4 = d;
+                    best_score = score;
+                }
+            }
+            if (!t3) break;
+
+            // 2-opt step: reverse the path t2 .. t4 (in array order for dir 0)
+            int i = dir ? ind->position[t4] : ind->position[t2];
+            int j = dir ? ind->position[t2] : ind->position[t4];
+            TwoOptReverse(ind, i, j);
+            undo_i[depth] = i;
+            undo_j[depth] = j;
+
+            added += DIST(dist, t2 - 1, t3 - 1);
+            removed += DIST(dist, t4 - 1, t3 - 1);
+            added_a[depth] = t2;
+            added_b[depth] = t3;
+            nodes[2 * depth] = t2;
+            nodes[2 * depth + 1] = t3;
+            depth++;
+
+            // The ring now holds the closing edge (t1, t4)
+            cost_t closed = added + DIST(dist, t4 - 1, t1 - 1);
+            if (COST_IMPROVES(closed, removed) && removed - closed > best_gain) {
+                best_gain = removed - closed;
+                best_depth = depth;
+            }
+
+            t2 = t4;
+            dir = (RING_NEXT(ind, t1) == t4) ? 0 : 1;
+        }
+
+        // Roll back to the best depth
+        for (int k = depth - 1; k >= best_depth; k--) {
+            TwoOptReverse(ind, undo_i[k], undo_j[k]);
+        }
+
+        if (best_depth > 0) {
+            if (ind->cached_cost < 1e17) {
+                ind->cached_cost -= alpha * best_gain;
+            }
+            int n = 0;
+            touched[n++] = t1;
+            for (int k = 0; k < 2 * best_depth; k++) {
+                touched[n++] = nodes[k];
+            }
+            touched[n++] = SUCC(ind, t1, 0);
+            touched[n++] = SUCC(ind, t1, 1);
+            return n;
+        }
+    }
+    return 0;
+}
+
+// =============================================================================
+// QUEUE
+// =============================================================================
+
+// Chains between two deadline checks
+#define LK_CLOCK_EVERY 64
+
+// Process the queue until it is empty or the deadline has passed
+static int lk_search(Individual* ind, int alpha, const DistMatrix* dist,
+                     const Ranking* ranking, Workspace* ws,
+                     const SearchScope* scope)
+{
+    int m = ind->ring_size;
+    uint32_t* look = ws->bits;
+    int* queue = ws->ids;
+    int head = 0, count = 0;
+    int touched[2 * LK_MAX_DEPTH + 3];
+    int moves = 0;
+    int chains = 0;
+
+    Bitset_Clear(look, ws->total_stations);
+    for (int k = 0; k < scope->num_seeds; k++) {
+        QUEUE_PUSH(ind->active_ring[(scope->first + k) % m]);
+    }
+
+    while (count > 0) {
+        if (scope->deadline && ++chains % LK_CLOCK_EVERY == 0 && clock() >= scope->deadline) break;
+
+        int t1 = queue[head];
+        head = (head + 1 == m) ? 0 : head + 1;
+        count--;
+        BITSET_CLEAR(look, t1);
+
+        int n = lk_move(ind, t1, dist, ranking, alpha, touched);
+        if (n > 0) moves++;
+        for (int k = 0; k < n; k++) {
+            QUEUE_PUSH(touched[k]);
+        }
+    }
+    return moves;
+}
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+int LinKernighan(Individual* ind, int alpha, const DistMatrix* dist,
+                 const Ranking* ranking, Workspace* ws)
+{
+    return LinKernighanUntil(ind, alpha, dist, ranking, ws, 0);
+}
+
+int LinKernighanUntil(Individual* ind, int alpha, const DistMatrix* dist,
+                      const Ranking* ranking, Workspace* ws, clock_t deadline)
+{
+    if (!ind || !dist || !ranking) return 0;
+    int m = ind->ring_size;
+    if (m < 5) return 0;
+
+    SearchScope scope = { 0, m, 0, 0, 0, deadline };
+    return NeighborSearch_Run(lk_search, ind, alpha, dist, ranking, ws, &scope);
+}
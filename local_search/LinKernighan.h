@@ -0,0 +1,42 @@
+// local_search/LinKernighan.h
+// Lin-Kernighan style variable-depth local search on the ring order
+//
+// A move starts by breaking a ring edge (t1, t2) and grows a chain of up to
+// LK_MAX_DEPTH 2-opt steps: t2 is joined to a ranking candidate t3, the
+// edge (t4, t3) is broken so that closing (t4, t1) gives a ring again, and
+// t4 becomes the new t2. Steps are applied on the array tour as they are
+// chosen (through the position index) and the chain is rolled back to the
+// depth with the best closed gain. The partial gain must stay positive, so
+// candidates are pruned as in the 2-opt; an edge added by the chain is
+// never broken again by it.
+//
+// This reaches moves of depth 3 and more (including the sequential 3-opt
+// moves the 2-opt and Or-opt cannot do in one step), with the same
+// don't-look bits and dirty-node queue. Used as an init-time polisher and on
+// the best elite of each species when it changed (local_search/Vnd.h).
+//
+// Keeps a valid ind->cached_cost and position index up to date and returns
+// the number of moves applied.
+// ws may be NULL (temporary workspace).
+
+#ifndef LIN_KERNIGHAN_H
+#define LIN_KERNIGHAN_H
+
+#include "core\Individual.h"
+#include "utils\Ranking.h"
+#include "utils\Workspace.h"
+#include <time.h>
+
+// Longest chain of 2-opt steps in one move
+#define LK_MAX_DEPTH 10
+
+// Improve the ring until no chain from any ring node improves it
+int LinKernighan(Individual* ind, int alpha, const DistMatrix* dist,
+                 const Ranking* ranking, Workspace* ws);
+
+// Same, stopping between two chains once clock() reaches deadline (0: no
+// limit)
+int LinKernighanUntil(Individual* ind, int alpha, const DistMatrix* dist,
+                      const Ranking* ranking, Workspace* ws, clock_t deadline);
+
+#endif // LIN_KERNIGHAN_H
@@ -0,0 +1,193 @@
+// local_search/MaskLocalSearch.c
+// Implementation of the ring membership hill climbing
+
+#include "MaskLocalSearch.h"
+#include "core\Assignment.h"
+#include "cost\DeltaCost.h"
+
+// =============================================================================
+// RING EDITS (ring, position index and assignment cache together)
+// =============================================================================
+
+void MaskInsertAfter(Individual* ind, int pos, int station, const DistMatrix* dist)
+{
+    for (int i = ind->ring_size; i > pos + 1; --i) {
+        ind->active_ring[i] = ind->active_ring[i - 1];
+    }
+    ind->active_ring[pos + 1] = (gene_t)station;
+    ind->ring_size++;
+    Individual_SyncPositions(ind, pos + 1, ind->ring_size - 1);
+    Assignment_Insert(ind->assign, station, dist);
+}
+
+void MaskRemoveAt(Individual* ind, int idx, const DistMatrix* dist, const Ranking* ranking)
+{
+    int removed = ind->active_ring[idx];
+    for (int i = idx; i < ind->ring_size - 1; ++i) {
+        ind->active_ring[i] = ind->active_ring[i + 1];
+    }
+    ind->ring_size--;
+    ind->position[removed] = RING_POS_NONE;
+    Individual_SyncPositions(ind, idx, ind->ring_size - 1);
+    Assignment_Remove(ind->assign, removed, dist, ranking);
+}
+
+void MaskReplaceAt(Individual* ind, int idx, int station,
+                   const DistMatrix* dist, const Ranking* ranking)
+{
+    int removed = ind->active_ring[idx];
+    ind->active_ring[idx] = (gene_t)station;
+    ind->position[removed] = RING_POS_NONE;
+    ind->position[station] = (gene_t)idx;
+    Assignment_Insert(ind->assign, station, dist);
+    Assignment_Remove(ind->assign, removed, dist, ranking);
+}
+
+// =============================================================================
+// HILL CLIMBING
+// =============================================================================
+
+// A move must gain more than rounding: a drop and the add that undoes it
+// would otherwise both look improving, and a caller looping until no move is
+// applied (local_search/Vnd.h) would never stop
+#define MASK_IMPROVES(delta) ((delta) < 0 && !COST_EQUAL((delta), 0))
+
+#define OUT_OF_TIME(deadline) ((deadline) && clock() >= (deadline))
+
+static void apply_delta(Individual* ind, cost_t delta)
+{
+    if (ind->cached_cost < 1e17) {
+        ind->cached_cost += delta;
+    }
+}
+
+// One pass of the three moves, returns the number of moves applied
+static int mask_pass(Individual* ind, int alpha, int total_stations,
+                     const DistMatrix* dist, const Ranking* ranking,
+                     clock_t deadline)
+{
+    const Assignment* assign = ind->assign;
+    int applied = 0;
+
+    // ----- DROP -----
+    for (int i = 0; i < ind->ring_size && ind->ring_size > 3; ) {
+        if (OUT_OF_TIME(deadline)) return applied;
+        if (ind->active_ring[i] == 1) { i++; continue; }  // Depot stays
+
+        cost_t delta = Delta_Remove_Node_Cached(
+            alpha, ind->active_ring, ind->ring_size, assign, i, dist);
+        if (MASK_IMPROVES(delta)) {
+            apply_delta(ind, delta);
+            MaskRemoveAt(ind, i, dist, ranking);
+            applied++;
+        } else {
+            i++;
+        }
+    }
+
+    // ----- ADD (cheapest position) -----
+    for (int s = 1; s <= total_stations && ind->ring_size < ind->ring_capacity; s++) {
+        if (BITSET_TEST(assign->in_ring, s)) continue;
+        if (OUT_OF_TIME(deadline)) return applied;
+
+        int m = ind->ring_size;
+        int best_pos = 0;
+        cost_t best_edge = 0;
+        for (int pos = 0; pos < m; pos++) {
+            int a = ind->active_ring[pos];
+            int b = ind->active_ring[(pos + 1) % m];
+            cost_t edge = (cost_t)DIST(dist, a - 1, s - 1) + DIST(dist, s - 1, b - 1)
+                        - DIST(dist, a - 1, b - 1);
+            if (pos == 0 || edge < best_edge) {
+                best_edge = edge;
+                best_pos = pos;
+            }
+        }
+
+        cost_t delta = Delta_Insert_Node_Cached(
+            alpha, ind->active_ring, m, assign, best_pos, s, dist);
+        if (MASK_IMPROVES(delta)) {
+            apply_delta(ind, delta);
+            MaskInsertAfter(ind, best_pos, s, dist);
+            applied++;
+        }
+    }
+
+    // ----- SWAP (nearest off-ring stations, same slot) -----
+    for (int i = 0; i < ind->ring_size; i++) {
+        int r = ind->active_ring[i];
+        if (r == 1) continue;
+        if (OUT_OF_TIME(deadline)) return applied;
+
+        const rank_id_t* row = RANKING_ROW(ranking, r);
+        int best_s = 0;
+        cost_t best_delta = 0;
+        int tried = 0;
+        for (int k = 0; k < ranking->k && tried < MASK_SWAP_CANDIDATES; k++) {
+            int s = row[k];
+            if (s == r || BITSET_TEST(assign->in_ring, s)) continue;
+            tried++;
+
+            cost_t delta = Delta_Replace_Node_Cached(
+                alpha, ind->active_ring, ind->ring_size, assign, i, s, dist);
+            if (delta < best_delta) {
+                best_delta = delta;
+                best_s = s;
+            }
+        }
+
+        if (best_s && MASK_IMPROVES(best_delta)) {
+            apply_delta(ind, best_delta);
+            MaskReplaceAt(ind, i, best_s, dist, ranking);
+            applied++;
+        }
+    }
+
+    return applied;
+}
+
+int ImproveMaskLocal(
+    Individual* ind,
+    int alpha,
+    int total_stations,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    Workspace* ws)
+{
+    return ImproveMaskLocalUntil(ind, alpha, total_stations, dist, ranking, ws, 0);
+}
+
+int ImproveMaskLocalUntil(
+    Individual* ind,
+    int alpha,
+    int total_stations,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    Workspace* ws,
+    clock_t deadline)
+{
+    if (!ind || !dist || !ranking || ind->ring_size < 3) return 0;
+
+    Workspace* temp = ws ? NULL : Workspace_Create(total_stations);
+    if (!ws) ws = temp;
+    if (!ws) return 0;
+
+    int borrowed = Individual_BorrowPositions(ind, ws->position, ws->total_stations);
+    int borrowed_assign = (ind->assign == NULL);
+    if (borrowed_assign) {
+        Assignment_Build(ws->assign, ind->active_ring, ind->ring_size, dist, ranking);
+        ind->assign = ws->assign;
+    }
+
+    int moves = 0;
+    for (int pass = 0; pass < MASK_MAX_PASSES; pass++) {
+        int applied = mask_pass(ind, alpha, total_stations, dist, ranking, deadline);
+        moves += applied;
+        if (!applied || OUT_OF_TIME(deadline)) break;
+    }
+
+    if (borrowed_assign) ind->assign = NULL;
+    if (borrowed) ind->position = NULL;
+    Workspace_Free(temp);
+    return moves;
+}
@@ -1,15 +1,64 @@
-#pragma once
+// local_search/MaskLocalSearch.h
+// Hill climbing on ring membership: add, drop and swap stations
+//
+// Permutation searches (2-opt, Or-opt, LK) only reorder the ring; this one
+// changes which stations are in it, the move that trades ring length
+// against assignment cost. Each pass tries, with exact deltas from the
+// assignment cache (cost/DeltaCost.h), to:
+//   - drop a ring station (never the depot, the ring keeps 3 stations)
+//   - add an off-ring station at its cheapest ring position
+//   - swap a ring station with one of its MASK_SWAP_CANDIDATES nearest
+//     off-ring stations, in the same slot
+// and applies every improving move it finds. Passes repeat until none
+// improves, at most MASK_MAX_PASSES times.
+//
+// Uses ind->assign if attached, otherwise the workspace cache for the call.
+// Keeps a valid ind->cached_cost and position index up to date and returns
+// the number of moves applied.
+// ws may be NULL (temporary workspace).
 
-#include <vector>
-#include "core/Individual.h"
+#ifndef MASK_LOCAL_SEARCH_H
+#define MASK_LOCAL_SEARCH_H
 
-// Hill-climb on active_ring: add/remove nodes if it improves total cost
-void ImproveMaskLocal(
-    Individual& ind,
+#include "core\Individual.h"
+#include "utils\Ranking.h"
+#include "utils\Workspace.h"
+#include <time.h>
+
+// Off-ring stations tried per ring station by the swap move
+#define MASK_SWAP_CANDIDATES 8
+
+// Passes over the three moves before giving up on convergence
+#define MASK_MAX_PASSES 4
+
+// Ring edits behind the three moves, also used by the trajectory engines
+// (evolution/Trajectory.h). They update the ring, the position index and
+// ind->assign (all required), not cached_cost.
+//   MaskInsertAfter - insert 'station' between slots pos and pos + 1
+//   MaskRemoveAt    - remove the station at slot idx
+//   MaskReplaceAt   - put 'station' (off-ring) in slot idx
+void MaskInsertAfter(Individual* ind, int pos, int station, const DistMatrix* dist);
+void MaskRemoveAt(Individual* ind, int idx, const DistMatrix* dist, const Ranking* ranking);
+void MaskReplaceAt(Individual* ind, int idx, int station,
+                   const DistMatrix* dist, const Ranking* ranking);
+
+int ImproveMaskLocal(
+    Individual* ind,
     int alpha,
     int total_stations,
-    const std::vector<std::vector<double>>& dist,
-    const std::vector<std::vector<int>>& ranking);
-
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    Workspace* ws);
 
+// Same, stopping between two stations once clock() reaches deadline
+// (0: no limit). A pass on a large instance is O(N x m) for the adds alone.
+int ImproveMaskLocalUntil(
+    Individual* ind,
+    int alpha,
+    int total_stations,
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    Workspace* ws,
+    clock_t deadline);
 
+#endif // MASK_LOCAL_SEARCH_H
@@ -0,0 +1,21 @@
+// local_search/NeighborSearch.c
+// Implementation of the shared search runner
+
+#include "NeighborSearch.h"
+
+int NeighborSearch_Run(NeighborSearchFn search, Individual* ind, int alpha,
+                       const DistMatrix* dist, const Ranking* ranking,
+                       Workspace* ws, const SearchScope* scope)
+{
+    Workspace* temp = ws ? NULL : Workspace_Create(ranking->total_stations);
+    if (!ws) ws = temp;
+    if (!ws) return 0;
+
+    int borrowed = Individual_BorrowPositions(ind, ws->position, ws->total_stations);
+
+    int moves = search(ind, alpha, dist, ranking, ws, scope);
+
+    if (borrowed) ind->position = NULL;
+    Workspace_Free(temp);
+    return moves;
+}
@@ -0,0 +1,63 @@
+// local_search/NeighborSearch.h
+// Don't-look queue shared by the neighbor-list searches (2-opt, Or-opt, LK)
+//
+// A search keeps the ring nodes to examine in a FIFO queue of m slots
+// (ws->ids) with one don't-look bit per station (ws->bits): a node leaves
+// the queue with its bit clear and is queued again only when a move touches
+// one of its edges. QUEUE_PUSH expects the locals of that loop in scope:
+// look (bitset), queue, head, count and m (ring size).
+//
+// The searches run on the position index; NeighborSearch_Run lends the
+// workspace one to individuals without their own for the call.
+
+#ifndef NEIGHBOR_SEARCH_H
+#define NEIGHBOR_SEARCH_H
+
+#include "core\Individual.h"
+#include "utils\Ranking.h"
+#include "utils\Workspace.h"
+#include "utils\Bitset.h"
+#include <time.h>
+
+// Queue a ring node unless it is already waiting (bit clear = don't look)
+#define QUEUE_PUSH(s)                                   \
+    do {                                                \
+        if (!BITSET_TEST(look, (s))) {                  \
+            BITSET_SET(look, (s));                      \
+            queue[(head + count) % m] = (s);            \
+            count++;                                    \
+        }                                               \
+    } while (0)
+
+// Queue pops between two deadline checks (2-opt, Or-opt)
+#define SEARCH_CLOCK_EVERY 256
+
+// Is (x, y) the edge {u, v} that must not be broken (u = 0: none)
+#define FIXED_EDGE(x, y, u, v) \
+    ((u) && (((x) == (u) && (y) == (v)) || ((x) == (v) && (y) == (u))))
+
+// What one call searches: the num_seeds ring nodes from slot 'first' are
+// queued, the search stops after max_improvements moves (0: no limit) and
+// never breaks the edge {fix_u, fix_v} (fix_u = 0: none). A search that
+// reads the clock also stops at deadline (0: none).
+typedef struct {
+    int first;
+    int num_seeds;
+    int max_improvements;
+    int fix_u, fix_v;
+    clock_t deadline;
+} SearchScope;
+
+// Queue processing of one search (ws and the position index are set)
+typedef int (*NeighborSearchFn)(Individual* ind, int alpha, const DistMatrix* dist,
+                                const Ranking* ranking, Workspace* ws,
+                                const SearchScope* scope);
+
+// Run the search with a position index: the individual's own, or the
+// workspace one for the call. ws may be NULL (temporary workspace).
+// Returns the number of moves applied.
+int NeighborSearch_Run(NeighborSearchFn search, Individual* ind, int alpha,
+                       const DistMatrix* dist, const Ranking* ranking,
+                       Workspace* ws, const SearchScope* scope);
+
+#endif // NEIGHBOR_SEARCH_H
@@ -0,0 +1,208 @@
+// local_search/OrOpt.c
+// Implementation of the Or-opt segment relocation
+
+#include "OrOpt.h"
+#include "NeighborSearch.h"
+#include "utils\Bitset.h"
+#include "utils\Random.h"
+
+// =============================================================================
+// RING EDITS
+// =============================================================================
+
+// Slot offset of station x from slot p (x in the segment [p, p + len) iff < len)
+#define SEG_OFFSET(ind, x, p, m) (((ind)->position[x] - (p) + (m)) % (m))
+
+// Move the segment of len slots at p right after station x (not in it),
+// reversed or not, shifting whichever side of the ring is shorter
+static void move_segment(Individual* ind, int p, int len, int x, int reversed)
+{
+    int m = ind->ring_size;
+    gene_t seg[OROPT_MAX_SEGMENT];
+    for (int t = 0; t < len; t++) {
+        seg[t] = ind->active_ring[(p + t) % m];
+    }
+
+    int fwd = SEG_OFFSET(ind, x, (p + len - 1) % m, m);  // After the segment, up to x
+    int bwd = m - len - fwd;                              // After x, up to the segment
+    int start;
+
+    if (fwd <= bwd) {
+        for (int k = 0; k < fwd; k++) {
+            int dst = (p + k) % m;
+            int s = ind->active_ring[(p + len + k) % m];
+            ind->active_ring[dst] = (gene_t)s;
+            ind->position[s] = (gene_t)dst;
+        }
+        start = (p + fwd) % m;
+    } else {
+        for (int k = 0; k < bwd; k++) {
+            int dst = (p + len - 1 - k + m) % m;
+            int s = ind->active_ring[(p - 1 - k + m) % m];
+            ind->active_ring[dst] = (gene_t)s;
+            ind->position[s] = (gene_t)dst;
+        }
+        start = (p - bwd + m) % m;
+    }
+
+    for (int t = 0; t < len; t++) {
+        int dst = (start + t) % m;
+        gene_t s = reversed ? seg[len - 1 - t] : seg[t];
+        ind->active_ring[dst] = s;
+        ind->position[s] = (gene_t)dst;
+    }
+}
+
+// =============================================================================
+// NEIGHBOR-LIST OR-OPT
+// =============================================================================
+
+// Process the queue seeded from the scope until it is empty, the scope's
+// max_improvements moves were made or its deadline has passed. A queued node
+// s1 tries the segments s1..sL that start at it. The scope's fixed edge is
+// never broken.
+static int neighbor_or_opt(Individual* ind, int alpha, const DistMatrix* dist,
+                           const Ranking* ranking, Workspace* ws,
+                           const SearchScope* scope)
+{
+    int m = ind->ring_size;
+    int fix_u = scope->fix_u, fix_v = scope->fix_v;
+    int max_improvements = scope->max_improvements;
+    uint32_t* look = ws->bits;
+    int* queue = ws->ids;
+    int head = 0, count = 0;
+    int improvements = 0;
+    int pops = 0;
+
+    Bitset_Clear(look, ws->total_stations);
+    for (int k = 0; k < scope->num_seeds; k++) {
+        int s = ind->active_ring[(scope->first + k) % m];
+        QUEUE_PUSH(s);
+    }
+
+    while (count > 0) {
+        if (scope->deadline && ++pops % SEARCH_CLOCK_EVERY == 0 && clock() >= scope->deadline) break;
+
+        int s1 = queue[head];
+        head = (head + 1 == m) ? 0 : head + 1;
+        count--;
+        BITSET_CLEAR(look, s1);
+
+        int moved = 0;
+        for (int len = 1; len <= OROPT_MAX_SEGMENT && len + 3 <= m && !moved; len++) {
+            int p = ind->position[s1];
+            int sL = ind->active_ring[(p + len - 1) % m];
+            int prev = ind->active_ring[(p - 1 + m) % m];
+            int next = ind->active_ring[(p + len) % m];
+            if (FIXED_EDGE(prev, s1, fix_u, fix_v) || FIXED_EDGE(sL, next, fix_u, fix_v)) continue;
+
+            dist_t d_in = DIST(dist, prev - 1, s1 - 1);
+            dist_t d_out = DIST(dist, sL - 1, next - 1);
+            dist_t d_join = DIST(dist, prev - 1, next - 1);
+            cost_t removed = (cost_t)d_in + d_out;
+            if (!COST_IMPROVES(d_join, removed)) continue;  // Nothing to gain
+
+            // end 0: s1 goes next to a candidate c of s1, end 1: sL next to one
+            // of sL. The new edge at u must be shorter than the one u loses.
+            for (int end = 0; end < 2 && !moved; end++) {
+                if (end == 1 && len == 1) break;
+                int u = end ? sL : s1;
+                int w = end ? s1 : sL;
+                dist_t limit = end ? d_out : d_in;
+                const rank_id_t* row = RANKING_ROW(ranking, u);
+
+                for (int r = 0; r < ranking->k && !moved; r++) {
+                    int c = row[r];
+                    if (c == u || !RING_CONTAINS(ind, c)) continue;
+
+                    dist_t d_uc = DIST(dist, u - 1, c - 1);
+                    if (d_uc >= limit) break;  // Candidates only get farther
+                    if (SEG_OFFSET(ind, c, p, m) < len) continue;
+
+                    // side 0: between c and next c, side 1: between prev c and c
+                    for (int side = 0; side < 2; side++) {
+                        int e = side ? RING_PREV(ind, c) : RING_NEXT(ind, c);
+                        if (SEG_OFFSET(ind, e, p, m) < len) continue;
+                        if (FIXED_EDGE(c, e, fix_u, fix_v)) continue;
+
+                        cost_t d0 = removed + DIST(dist, c - 1, e - 1);
+                        cost_t d1 = (cost_t)d_join + d_uc + DIST(dist, w - 1, e - 1);
+                        if (!COST_IMPROVES(d1, d0)) continue;
+
+                        if (ind->cached_cost < 1e17) {
+                            ind->cached_cost += alpha * (d1 - d0);
+                        }
+                        // Inserted after x; reversed when sL comes first
+                        int x = side ? e : c;
+                        int reversed = side ? !end : end;
+                        move_segment(ind, p, len, x, reversed);
+
+                        QUEUE_PUSH(prev);
+                        QUEUE_PUSH(next);
+                        QUEUE_PUSH(s1);
+                        QUEUE_PUSH(sL);
+                        QUEUE_PUSH(c);
+                        QUEUE_PUSH(e);
+                        moved = 1;
+                        improvements++;
+                        break;
+                    }
+                }
+            }
+        }
+        if (max_improvements > 0 && improvements >= max_improvements) break;
+    }
+    return improvements;
+}
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+int OrOptImproveAlpha(Individual* ind, int alpha, const DistMatrix* dist,
+                      const Ranking* ranking, Workspace* ws)
+{
+    if (!ind || !dist || !ranking) return 0;
+    int m = ind->ring_size;
+    if (m < 4) return 0;
+
+    // Improvement cap of the adaptive 2-opt, on a shorter window: a node
+    // tries up to 3 segments in both orientations, and this runs after it
+    int max_improvements = m / 4;
+    if (max_improvements < 3) max_improvements = 3;
+    if (max_improvements > 20) max_improvements = 20;
+
+    int window_size = m / 8;
+    if (window_size < 5) window_size = 5;
+    if (window_size > m) window_size = m;
+
+    SearchScope scope = { RandInt(0, m - 1), window_size, max_improvements, 0, 0, 0 };
+    return NeighborSearch_Run(neighbor_or_opt, ind, alpha, dist, ranking, ws, &scope);
+}
+
+int OrOptExhaustive(Individual* ind, int alpha, const DistMatrix* dist,
+                    const Ranking* ranking, Workspace* ws)
+{
+    return OrOptExhaustiveUntil(ind, alpha, dist, ranking, ws, 0);
+}
+
+int OrOptExhaustiveUntil(Individual* ind, int alpha, const DistMatrix* dist,
+                         const Ranking* ranking, Workspace* ws, clock_t deadline)
+{
+    if (!ind || !dist || !ranking) return 0;
+    if (ind->ring_size < 4) return 0;
+
+    SearchScope scope = { 0, ind->ring_size, 0, 0, 0, deadline };
+    return NeighborSearch_Run(neighbor_or_opt, ind, alpha, dist, ranking, ws, &scope);
+}
+
+int OrOptPath(Individual* ind, int alpha, const DistMatrix* dist,
+              const Ranking* ranking, Workspace* ws, clock_t deadline)
+{
+    if (!ind || !dist || !ranking) return 0;
+    int m = ind->ring_size;
+    if (m < 4) return 0;
+
+    SearchScope scope = { 0, m, 0, ind->active_ring[m - 1], ind->active_ring[0], deadline };
+    return NeighborSearch_Run(neighbor_or_opt, ind, alpha, dist, ranking, ws, &scope);
+}
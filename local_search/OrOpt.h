@@ -0,0 +1,44 @@
+// local_search/OrOpt.h
+// Or-opt local search: relocate a segment of 1 to 3 ring stations
+//
+// A segment s1..sL is cut out (its neighbors are joined) and reinserted,
+// in either orientation, next to a ranking candidate of s1 or sL. Deltas
+// are O(1) (six edges) and candidates are pruned like in the 2-opt, with the
+// same don't-look bits and dirty-node queue. It finds the relocations the
+// 2-opt cannot express as one reversal.
+//
+// Both modes keep a valid ind->cached_cost and position index up to date
+// move by move, and return the number of moves applied. ws may be NULL
+// (temporary workspace).
+
+#ifndef OROPT_H
+#define OROPT_H
+
+#include "core\Individual.h"
+#include "utils\Ranking.h"
+#include "utils\Workspace.h"
+#include <time.h>
+
+// Longest segment moved
+#define OROPT_MAX_SEGMENT 3
+
+// Adaptive mode (evolution): random window of 1/8 of the ring, limited improvements
+int OrOptImproveAlpha(Individual* ind, int alpha, const DistMatrix* dist,
+                      const Ranking* ranking, Workspace* ws);
+
+// Exhaustive mode (initialization): every ring node, until convergence
+int OrOptExhaustive(Individual* ind, int alpha, const DistMatrix* dist,
+                    const Ranking* ranking, Workspace* ws);
+
+// Same, stopping between two queue pops once clock() reaches deadline (0: no
+// limit)
+int OrOptExhaustiveUntil(Individual* ind, int alpha, const DistMatrix* dist,
+                         const Ranking* ranking, Workspace* ws, clock_t deadline);
+
+// Exhaustive mode on a path: the closing edge (ring[m - 1], ring[0]) is
+// never broken, the ring may come back rotated (local_search/Partition.h).
+// Stops once clock() reaches deadline (0: no limit).
+int OrOptPath(Individual* ind, int alpha, const DistMatrix* dist,
+              const Ranking* ranking, Workspace* ws, clock_t deadline);
+
+#endif // OROPT_H
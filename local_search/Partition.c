@@ -0,0 +1,240 @@
+// local_search/Partition.c
+// Implementation of the partitioned local search
+
+#include "Partition.h"
+#include "local_search\TwoOpt.h"
+#include "local_search\OrOpt.h"
+#include "utils\ThreadPool.h"
+#include <stdlib.h>
+
+typedef struct {
+    int from, size;     // Slots [from, from + size) of the ring
+    int moves;
+} PartitionSlice;
+
+typedef struct {
+    Individual* ind;
+    int alpha;
+    const DistMatrix* dist;
+    const Ranking* ranking;
+    PartitionSlice* slices;
+    clock_t deadline;
+} PartitionJob;
+
+// Is there time left before deadline (0: no limit)
+#define TIME_LEFT(deadline) (!(deadline) || clock() < (deadline))
+
+// Length of the closed ring
+static cost_t ring_length(const Individual* ind, const DistMatrix* dist)
+{
+    int m = ind->ring_size;
+    cost_t length = 0;
+    for (int i = 0; i < m; i++) {
+        int next = (i + 1 == m) ? 0 : i + 1;
+        length += DIST(dist, ind->active_ring[i] - 1, ind->active_ring[next] - 1);
+    }
+    return length;
+}
+
+// =============================================================================
+// REGIONS
+// =============================================================================
+
+// Regroup the ring into count regions of nearby stations and fill slices
+// (one per region, in ring order). Seeds are spread by farthest-point
+// sampling from ring[0]; every station joins its nearest seed; regions are
+// chained nearest seed first and keep the ring order of their stations.
+// Slots of a random ring would give slices scattered over the whole
+// instance, with most of the work left to the repair pass.
+static int regroup_regions(Individual* ind, const DistMatrix* dist,
+                           PartitionSlice* slices, int count, Workspace* ws)
+{
+    int m = ind->ring_size;
+    gene_t* ring = ind->active_ring;
+    int* region = (int*)malloc(m * sizeof(int));
+    dist_t* nearest = (dist_t*)malloc(m * sizeof(dist_t));
+    int* seeds = (int*)malloc(count * sizeof(int));
+    int* order = (int*)malloc(count * sizeof(int));
+    if (!region || !nearest || !seeds || !order) {
+        free(region); free(nearest); free(seeds); free(order);
+        return 0;
+    }
+
+    // Seeds and nearest seed of every slot
+    int far = 0;
+    for (int g = 0; g < count; g++) {
+        seeds[g] = ring[far];
+        dist_t best = -1;
+        for (int i = 0; i < m; i++) {
+            dist_t d = DIST(dist, seeds[g] - 1, ring[i] - 1);
+            if (g == 0 || d < nearest[i]) {
+                nearest[i] = d;
+                region[i] = g;
+            }
+            if (nearest[i] > best) {
+                best = nearest[i];
+                far = i;
+            }
+        }
+    }
+
+    // Chain the regions: nearest unvisited seed next
+    for (int g = 0; g < count; g++) order[g] = g;
+    for (int g = 1; g < count; g++) {
+        int pick = g;
+        for (int h = g + 1; h < count; h++) {
+            if (DIST(dist, seeds[order[g - 1]] - 1, seeds[order[h]] - 1) <
+                DIST(dist, seeds[order[g - 1]] - 1, seeds[order[pick]] - 1)) pick = h;
+        }
+        int t = order[g]; order[g] = order[pick]; order[pick] = t;
+    }
+
+    // Stable regroup through ws->ids
+    int from = 0;
+    for (int g = 0; g < count; g++) {
+        slices[g].from = from;
+        for (int i = 0; i < m; i++) {
+            if (region[i] == order[g]) ws->ids[from++] = ring[i];
+        }
+        slices[g].size = from - slices[g].from;
+    }
+
+    // Path ends: the stations facing the previous and the next region
+    for (int g = 0; g < count; g++) {
+        int* ids = ws->ids + slices[g].from;
+        int size = slices[g].size;
+        if (size < 3) continue;
+        int prev_seed = seeds[order[(g - 1 + count) % count]];
+        int next_seed = seeds[order[(g + 1) % count]];
+        int head = 0, tail = size - 1;
+        for (int i = 1; i < size; i++) {
+            if (DIST(dist, prev_seed - 1, ids[i] - 1) < DIST(dist, prev_seed - 1, ids[head] - 1)) head = i;
+        }
+        int t = ids[0]; ids[0] = ids[head]; ids[head] = t;
+        for (int i = 1; i < size - 1; i++) {
+            if (DIST(dist, next_seed - 1, ids[i] - 1) < DIST(dist, next_seed - 1, ids[tail] - 1)) tail = i;
+        }
+        t = ids[size - 1]; ids[size - 1] = ids[tail]; ids[tail] = t;
+    }
+    for (int i = 0; i < m; i++) {
+        ring[i] = (gene_t)ws->ids[i];
+    }
+
+    free(region); free(nearest); free(seeds); free(order);
+    return 1;
+}
+
+// =============================================================================
+// SLICE JOB
+// =============================================================================
+
+// A path search may leave the cycle rotated or reversed: read it again from
+// 'first' away from 'last', so the path ends are back in the end slots
+static void restore_ends(gene_t* ring, int size, int first, int last, Workspace* ws)
+{
+    if (ring[0] == first && ring[size - 1] == last) return;
+
+    int p = 0;
+    while (ring[p] != first) p++;
+    int step = (ring[(p + 1) % size] == last) ? size - 1 : 1;
+    for (int k = 0; k < size; k++) {
+        ws->ids[k] = ring[p];
+        p = (p + step) % size;
+    }
+    for (int k = 0; k < size; k++) {
+        ring[k] = (gene_t)ws->ids[k];
+    }
+}
+
+static void slice_job(void* context, int index, Workspace* ws)
+{
+    PartitionJob* job = (PartitionJob*)context;
+    PartitionSlice* slice = &job->slices[index];
+    gene_t* ring = job->ind->active_ring + slice->from;
+    int size = slice->size;
+    int first = ring[0];
+    int last = ring[size - 1];
+
+    // The slice as a ring of its own, closed by the fixed edge (last, first)
+    Individual part;
+    part.active_ring = ring;
+    part.ring_size = size;
+    part.ring_capacity = size;
+    part.cached_cost = 1e18;
+    part.assign = NULL;
+    part.position = NULL;
+
+    int moves = TwoOptPath(&part, job->alpha, job->dist, job->ranking, ws, job->deadline);
+    restore_ends(ring, size, first, last, ws);
+    int relocated;
+    while (TIME_LEFT(job->deadline) &&
+           (relocated = OrOptPath(&part, job->alpha, job->dist, job->ranking, ws, job->deadline)) > 0) {
+        restore_ends(ring, size, first, last, ws);
+        moves += relocated;
+        moves += TwoOptPath(&part, job->alpha, job->dist, job->ranking, ws, job->deadline);
+        restore_ends(ring, size, first, last, ws);
+    }
+
+    slice->moves = moves;
+}
+
+// =============================================================================
+// DRIVER
+// =============================================================================
+
+int PartitionedLocalSearch(Individual* ind, int alpha, const DistMatrix* dist,
+                           const Ranking* ranking, Workspace* ws, clock_t deadline)
+{
+    if (!ind || !dist || !ranking) return 0;
+    int m = ind->ring_size;
+    if (m < PARTITION_MIN_RING) return 0;
+    if (!TIME_LEFT(deadline)) return 0;
+
+    int count = ThreadPool_NumWorkers();
+    if (count > m / PARTITION_MIN_SLICE) count = m / PARTITION_MIN_SLICE;
+    if (count < 2) return 0;
+
+    PartitionSlice* slices = (PartitionSlice*)calloc(count, sizeof(PartitionSlice));
+    Workspace* temp = ws ? NULL : Workspace_Create(ranking->total_stations);
+    if (!ws) ws = temp;
+    if (!slices || !ws) {
+        free(slices);
+        Workspace_Free(temp);
+        return 0;
+    }
+
+    cost_t before = ring_length(ind, dist);
+    if (!regroup_regions(ind, dist, slices, count, ws)) {
+        free(slices);
+        Workspace_Free(temp);
+        return 0;
+    }
+
+    PartitionJob job = { ind, alpha, dist, ranking, slices, deadline };
+    ThreadPool_RunJobs(slice_job, &job, count);
+
+    int moves = 0;
+    for (int k = 0; k < count; k++) {
+        moves += slices[k].moves;
+    }
+    free(slices);
+
+    if (ind->position) {
+        Individual_SyncPositions(ind, 0, m - 1);
+    }
+    if (ind->cached_cost < 1e17) {
+        ind->cached_cost += alpha * (ring_length(ind, dist) - before);
+    }
+
+    // Boundary repair: every node is queued, but only the ones near a slice
+    // end have moves left
+    moves += TwoOptExhaustiveUntil(ind, alpha, dist, ranking, ws, deadline);
+    int relocated;
+    while (TIME_LEFT(deadline) &&
+           (relocated = OrOptExhaustiveUntil(ind, alpha, dist, ranking, ws, deadline)) > 0) {
+        moves += relocated;
+        moves += TwoOptExhaustiveUntil(ind, alpha, dist, ranking, ws, deadline);
+    }
+    Workspace_Free(temp);
+    return moves;
+}
@@ -0,0 +1,38 @@
+// local_search/Partition.h
+// Parallel local search on one large ring
+//
+// The ring is regrouped into one region of nearby stations per worker
+// thread (farthest-point seeds, nearest seed), laid out one after the other.
+// Each region is improved as a path (2-opt and Or-opt that never break the
+// edge closing it, local_search/TwoOpt.h and OrOpt.h), all regions at the
+// same time on the thread pool: the stations at the two ends of a region
+// stay there, so the regions are written back in place. A serial exhaustive
+// 2-opt and Or-opt on the whole ring then repairs the boundaries.
+//
+// The regrouping throws the tour order away: this is meant for random
+// initial rings, where it also gives a better start than the ring order.
+//
+// Must be called from the main thread while the pool is idle (jobs cannot
+// submit jobs). Keeps a valid ind->cached_cost and position index up to date.
+// ws may be NULL (temporary workspace for the repair pass).
+
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include "core\Individual.h"
+#include "utils\Ranking.h"
+#include "utils\Workspace.h"
+#include <time.h>
+
+// Smallest ring worth splitting, and smallest average region
+#define PARTITION_MIN_RING 2000
+#define PARTITION_MIN_SLICE 500
+
+// Improve ind with the regions then the repair pass, returns the number of
+// moves applied. Both stop once clock() reaches deadline (0: no limit).
+// Returns 0 without touching ind when the ring is too small, there is no
+// thread pool (fewer than 2 regions) or the deadline has already passed.
+int PartitionedLocalSearch(Individual* ind, int alpha, const DistMatrix* dist,
+                           const Ranking* ranking, Workspace* ws, clock_t deadline);
+
+#endif // PARTITION_H
@@ -1,135 +1,355 @@
 // local_search/TwoOpt.c - 2-opt local search implementation
 //
 // DEUX MODES DE 2-OPT :
-// 1. EXHAUSTIF (pour initialisation) : Parcourt tout, jusqu' convergence
-// 2. ADAPTATIF (pour volution) : Fentre alatoire, nombre limit d'amliorations
+// 1. EXHAUSTIF (pour initialisation) : tous les noeuds du ring, jusqu' convergence
+// 2. ADAPTATIF (pour volution) : fentre alatoire, nombre limit d'amliorations
+//
+// Both modes use neighbor lists: a ring node a only tries to reconnect to
+// the ring stations among its ranking candidates, nearest first, and stops
+// as soon as the new edge is not shorter than the one it replaces. Nodes to
+// examine wait in a FIFO queue; a node leaves it with its don't-look bit set
+// and is queued again only when a move touches one of its edges. A pass is
+// O(m * K) instead of O(m).
+//
+// Moves are found and applied through the position index (ind->position);
+// individuals without one borrow the workspace index for the call. Rings of
+// TWO_OPT_LIST_MIN_RING stations or more are copied into the workspace
+// two-level list (core/TwoLevelList.h) for the search, where a reversal
+// costs O(sqrt(m)) instead of O(m), and written back at the end.
 //
 #include "TwoOpt.h"
+#include "NeighborSearch.h"
+#include "core\TwoLevelList.h"
+#include "utils\Bitset.h"
 #include "utils\Random.h"
 #include <stdio.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 // =============================================================================
-// 2-OPT ADAPTATIF (utilis pendant l'volution)
+// RING EDITS
 // =============================================================================
-// Au lieu de parcourir TOUT le ring (O(n)), on:
-// 1. Choisit un point de dpart alatoire
-// 2. Parcourt une fentre de taille proportionnelle au ring
-// 3. S'arrte aprs un nombre limit d'amliorations
-//
-// IMPORTANT: On travaille sur des indices LINAIRES dans [start, end]
-// pour viter les bugs de wrap-around lors du reverse.
-//
-void TwoOptImproveAlpha(Individual* ind, int alpha, const double** dist, const int** ranking)
+
+void TwoOptReverse(Individual* ind, int i, int j)
+{
+    int m = ind->ring_size;
+    int len = (j - i + m) % m + 1;
+    if (2 * len > m) {
+        int tmp = (j + 1) % m;
+        j = (i - 1 + m) % m;
+        i = tmp;
+        len = m - len;
+    }
+    for (int k = 0; k < len / 2; k++) {
+        int a = ind->active_ring[i];
+        int b = ind->active_ring[j];
+        ind->active_ring[i] = (gene_t)b;
+        ind->active_ring[j] = (gene_t)a;
+        ind->position[b] = (gene_t)i;
+        ind->position[a] = (gene_t)j;
+        i = (i + 1 == m) ? 0 : i + 1;
+        j = (j == 0) ? m - 1 : j - 1;
+    }
+}
+
+// Tour neighbors: two-level list when the search runs on one, else the array
+#define TOUR_NEXT(s) (tl ? TwoLevelList_Next(tl, (s)) : RING_NEXT(ind, (s)))
+#define TOUR_PREV(s) (tl ? TwoLevelList_Prev(tl, (s)) : RING_PREV(ind, (s)))
+
+// =============================================================================
+// NEIGHBOR-LIST 2-OPT
+// =============================================================================
+
+// Process the queue seeded from the scope until it is empty, the scope's
+// max_improvements moves were made or its deadline has passed. The scope's
+// fixed edge is never broken.
+static int neighbor_two_opt(Individual* ind, int alpha, const DistMatrix* dist,
+                            const Ranking* ranking, Workspace* ws,
+                            const SearchScope* scope)
 {
-    if (!ind || !dist) return;
     int m = ind->ring_size;
-    if (m <= 3) return;
+    int fix_u = scope->fix_u, fix_v = scope->fix_v;
+    int max_improvements = scope->max_improvements;
+    uint32_t* look = ws->bits;
+    int* queue = ws->ids;
+    int head = 0, count = 0;
+    int improvements = 0;
+    int pops = 0;
+
+    TwoLevelList* tl = (m >= TWO_OPT_LIST_MIN_RING) ? ws->tour : NULL;
+    if (tl) TwoLevelList_FromRing(tl, ind->active_ring, m);
+
+    Bitset_Clear(look, ws->total_stations);
+    for (int k = 0; k < scope->num_seeds; k++) {
+        int s = ind->active_ring[(scope->first + k) % m];
+        QUEUE_PUSH(s);
+    }
+
+    while (count > 0) {
+        if (scope->deadline && ++pops % SEARCH_CLOCK_EVERY == 0 && clock() >= scope->deadline) break;
+
+        int a = queue[head];
+        head = (head + 1 == m) ? 0 : head + 1;
+        count--;
+        BITSET_CLEAR(look, a);
+
+        const rank_id_t* row = RANKING_ROW(ranking, a);
+        int moved = 0;
 
-    // Validate indices
-    for (int i = 0; i < m; ++i) {
-        if (ind->active_ring[i] <= 0) return;
+        // dir 0: (a, next a) + (c, next c) -> (a, c) + (next a, next c)
+        // dir 1: (prev a, a) + (prev c, c) -> (a, c) + (prev a, prev c)
+        for (int dir = 0; dir < 2 && !moved; dir++) {
+            int b = dir ? TOUR_PREV(a) : TOUR_NEXT(a);
+            if (FIXED_EDGE(a, b, fix_u, fix_v)) continue;
+            dist_t d_ab = DIST(dist, a - 1, b - 1);
+
+            for (int r = 0; r < ranking->k; r++) {
+                int c = row[r];
+                if (c == a || !RING_CONTAINS(ind, c)) continue;
+
+                dist_t d_ac = DIST(dist, a - 1, c - 1);
+                if (d_ac >= d_ab) break;  // Candidates only get farther
+                if (c == b) continue;
+
+                int d = dir ? TOUR_PREV(c) : TOUR_NEXT(c);
+                if (d == a || FIXED_EDGE(c, d, fix_u, fix_v)) continue;
+
+                cost_t d0 = (cost_t)d_ab + DIST(dist, c - 1, d - 1);
+                cost_t d1 = (cost_t)d_ac + DIST(dist, b - 1, d - 1);
+                if (!COST_IMPROVES(d1, d0)) continue;
+
+                if (ind->cached_cost < 1e17) {
+                    ind->cached_cost += alpha * (d1 - d0);
+                }
+                if (tl) {
+                    if (dir) TwoLevelList_Reverse(tl, a, d);
+                    else     TwoLevelList_Reverse(tl, b, c);
+                } else {
+                    int pa = ind->position[a];
+                    int pc = ind->position[c];
+                    if (dir) {
+                        TwoOptReverse(ind, pa, (pc - 1 + m) % m);  // a .. prev c
+                    } else {
+                        TwoOptReverse(ind, (pa + 1) % m, pc);      // next a .. c
+                    }
+                }
+
+                QUEUE_PUSH(a);
+                QUEUE_PUSH(b);
+                QUEUE_PUSH(c);
+                QUEUE_PUSH(d);
+                moved = 1;
+                improvements++;
+                break;
+            }
+        }
+        if (max_improvements > 0 && improvements >= max_improvements) break;
     }
 
+    // Membership never changed: the position index only needs the new order
+    if (tl && improvements > 0) {
+        TwoLevelList_ToRing(tl, ind->active_ring, ind->active_ring[0]);
+        Individual_SyncPositions(ind, 0, m - 1);
+    }
+    return improvements;
+}
+
+// =============================================================================
+// 2-OPT ADAPTATIF (utilis pendant l'volution)
+// =============================================================================
+// Au lieu de parcourir TOUT le ring, on:
+// 1. Met en file une fentre alatoire du ring (la moiti)
+// 2. S'arrte aprs un nombre limit d'amliorations
+//
+int TwoOptImproveAlpha(Individual* ind, int alpha, const DistMatrix* dist,
+                       const Ranking* ranking, Workspace* ws)
+{
+    if (!ind || !dist || !ranking) return 0;
+    int m = ind->ring_size;
+    if (m <= 3) return 0;
+
     // Paramtres adaptatifs
     int max_improvements = m / 4;
     if (max_improvements < 3) max_improvements = 3;
     if (max_improvements > 20) max_improvements = 20;
-    
+
     // Taille de la fentre (portion du ring  explorer)
     int window_size = m / 2;
     if (window_size < 5) window_size = 5;
-    if (window_size > m - 2) window_size = m - 2;
-    
-    // Point de dpart alatoire, s'assurer qu'on ne dpasse pas
-    int max_start = m - window_size - 1;
-    if (max_start < 0) max_start = 0;
-    
-    int start = (max_start > 0) ? RandInt(0, max_start) : 0;
-    int end = start + window_size;
-    if (end >= m) end = m - 1;
-    
-    int improvements = 0;
-    
-    // Parcourir la fentre [start, end] avec indices linaires (pas de wrap)
-    for (int i = start; i < end - 1 && improvements < max_improvements; ++i) {
-        for (int j = i + 2; j <= end && improvements < max_improvements; ++j) {
-            
-            // Tous les accs sont dans [0, m-1] car i < end <= m-1 et j <= end
-            int id_a = ind->active_ring[i];
-            int id_b = ind->active_ring[i + 1];  // Safe: i < end-1, donc i+1 < end <= m-1
-            int id_c = ind->active_ring[j];
-            
-            // Pour id_d, on utilise modulo car j+1 peut tre = m
-            int id_d = ind->active_ring[(j + 1) % m];
-
-            double d0 = dist[id_a - 1][id_b - 1] + dist[id_c - 1][id_d - 1];
-            double d1 = dist[id_a - 1][id_c - 1] + dist[id_b - 1][id_d - 1];
-            
-            if (d1 < d0) {
-                // Reverse segment [i+1, j] - tous les indices sont dans [start, end]
-                int a = i + 1;
-                int b = j;
-                while (a < b) {
-                    int tmp = ind->active_ring[a];
-                    ind->active_ring[a] = ind->active_ring[b];
-                    ind->active_ring[b] = tmp;
-                    a++;
-                    b--;
-                }
-                improvements++;
-            }
-        }
-    }
+    if (window_size > m) window_size = m;
+
+    SearchScope scope = { RandInt(0, m - 1), window_size, max_improvements, 0, 0, 0 };
+    return NeighborSearch_Run(neighbor_two_opt, ind, alpha, dist, ranking, ws, &scope);
 }
 
 // =============================================================================
 // 2-OPT EXHAUSTIF (utilis pour l'initialisation de la population)
 // =============================================================================
-// Continue jusqu' ce qu'aucune amlioration ne soit possible.
-// Plus lent mais donne des solutions de meilleure qualit.
+// Tous les noeuds du ring sont mis en file ; continue jusqu' ce qu'aucun
+// mouvement des listes de voisins n'amliore le ring.
 //
-void TwoOptExhaustive(Individual* ind, int alpha, const double** dist, const int** ranking)
+int TwoOptExhaustive(Individual* ind, int alpha, const DistMatrix* dist,
+                     const Ranking* ranking, Workspace* ws)
+{
+    return TwoOptExhaustiveUntil(ind, alpha, dist, ranking, ws, 0);
+}
+
+int TwoOptExhaustiveUntil(Individual* ind, int alpha, const DistMatrix* dist,
+                          const Ranking* ranking, Workspace* ws, clock_t deadline)
+{
+    if (!ind || !dist || !ranking) return 0;
+    if (ind->ring_size <= 3) return 0;
+
+    SearchScope scope = { 0, ind->ring_size, 0, 0, 0, deadline };
+    return NeighborSearch_Run(neighbor_two_opt, ind, alpha, dist, ranking, ws, &scope);
+}
+
+int TwoOptPath(Individual* ind, int alpha, const DistMatrix* dist,
+               const Ranking* ranking, Workspace* ws, clock_t deadline)
 {
-    if (!ind || !dist) return;
+    if (!ind || !dist || !ranking) return 0;
     int m = ind->ring_size;
-    if (m <= 3) return;
+    if (m <= 3) return 0;
+
+    SearchScope scope = { 0, m, 0, ind->active_ring[m - 1], ind->active_ring[0], deadline };
+    return NeighborSearch_Run(neighbor_two_opt, ind, alpha, dist, ranking, ws, &scope);
+}
+
+// =============================================================================
+// 2-OPT BEST-IMPROVEMENT (balayage complet, SIMD)
+// =============================================================================
+// For each slot i, the gains of every partner j are computed together: the
+// ring is kept as 0-indexed ids (ids[m] = ids[0]) next to its edge lengths,
+// so a block of 4 partners is two gathers in the rows of a and b plus a
+// load. The best j is applied, then the sweep goes on. Only the stored
+// double matrix is vectorized (float / integer storage and matrix-free
+// mode use the scalar loop).
+//
+#if defined(__AVX2__) && !defined(DIST_FLOAT) && !defined(COST_INTEGER)
+#define TWO_OPT_SIMD
+#endif
+
+// Best gain d_ab + d_cd - d_ac - d_bd over j in [j_from, j_to] (c = ids[j],
+// d = ids[j + 1]); the lowest such j goes to *best_j
+static cost_t best_partner(const DistMatrix* dist, const int* ids, const cost_t* edge,
+                           int a, int b, cost_t d_ab, int j_from, int j_to, int* best_j)
+{
+    cost_t best = 0;
+    int bj = -1;
+    int j = j_from;
+
+#ifdef TWO_OPT_SIMD
+    if (dist->data && j_to - j_from >= 4) {
+        const double* row_a = DIST_ROW(dist, a);
+        const double* row_b = DIST_ROW(dist, b);
+        const __m256d vab = _mm256_set1_pd(d_ab);
+        const __m256i four = _mm256_set1_epi64x(4);
+        __m256d vbest = _mm256_set1_pd(-1e300);
+        __m256i vbest_j = _mm256_set1_epi64x(-1);
+        __m256i vj = _mm256_setr_epi64x(j, j + 1, j + 2, j + 3);
+
+        for (; j + 3 <= j_to; j += 4) {
+            __m128i c = _mm_loadu_si128((const __m128i*)(ids + j));
+            __m128i d = _mm_loadu_si128((const __m128i*)(ids + j + 1));
+            __m256d d_ac = _mm256_i32gather_pd(row_a, c, 8);
+            __m256d d_bd = _mm256_i32gather_pd(row_b, d, 8);
+            __m256d gain = _mm256_sub_pd(_mm256_add_pd(vab, _mm256_loadu_pd(edge + j)),
+                                         _mm256_add_pd(d_ac, d_bd));
+            __m256d better = _mm256_cmp_pd(gain, vbest, _CMP_GT_OQ);
+            vbest = _mm256_blendv_pd(vbest, gain, better);
+            vbest_j = _mm256_castpd_si256(_mm256_blendv_pd(
+                _mm256_castsi256_pd(vbest_j), _mm256_castsi256_pd(vj), better));
+            vj = _mm256_add_epi64(vj, four);
+        }
 
-    // Validate indices
-    for (int i = 0; i < m; ++i) {
-        if (ind->active_ring[i] <= 0) return;
+        double lanes[4];
+        long long lanes_j[4];
+        _mm256_storeu_pd(lanes, vbest);
+        _mm256_storeu_si256((__m256i*)lanes_j, vbest_j);
+        for (int k = 0; k < 4; k++) {
+            if (lanes_j[k] < 0) continue;
+            if (bj < 0 || lanes[k] > best || (lanes[k] == best && lanes_j[k] < bj)) {
+                best = lanes[k];
+                bj = (int)lanes_j[k];
+            }
+        }
     }
+#endif
 
-    int improved = 1;
+    // Scalar path (tail of the range, or whole range)
+    for (; j <= j_to; j++) {
+        cost_t gain = (d_ab + edge[j]) - (DIST(dist, a, ids[j]) + DIST(dist, b, ids[j + 1]));
+        if (bj < 0 || gain > best) {
+            best = gain;
+            bj = j;
+        }
+    }
+
+    *best_j = bj;
+    return best;
+}
+
+int TwoOptBestImprovement(Individual* ind, int alpha, const DistMatrix* dist, Workspace* ws)
+{
+    if (!ind || !dist) return 0;
+    int m = ind->ring_size;
+    if (m < 4) return 0;
+
+    Workspace* temp = ws ? NULL : Workspace_Create(dist->n);
+    if (!ws) ws = temp;
+    if (!ws) return 0;
+    int borrowed = Individual_BorrowPositions(ind, ws->position, ws->total_stations);
+
+    int* ids = ws->ids;
+    cost_t* edge = ws->lengths;
+    for (int k = 0; k < m; k++) ids[k] = ind->active_ring[k] - 1;
+    ids[m] = ids[0];
+    for (int k = 0; k < m; k++) edge[k] = DIST(dist, ids[k], ids[k + 1]);
 
+    int moves = 0;
+    int improved = 1;
     while (improved) {
         improved = 0;
-        
-        // i va de 0  m-2 (pour que i+1 soit valide)
-        for (int i = 0; i < m - 1; ++i) {
-            // j va de i+2  m-1
-            for (int j = i + 2; j < m; ++j) {
-                int id_a = ind->active_ring[i];
-                int id_b = ind->active_ring[i + 1];  // Safe: i < m-1
-                int id_c = ind->active_ring[j];
-                int id_d = ind->active_ring[(j + 1) % m];  // Modulo pour le wrap
-
-                double d0 = dist[id_a - 1][id_b - 1] + dist[id_c - 1][id_d - 1];
-                double d1 = dist[id_a - 1][id_c - 1] + dist[id_b - 1][id_d - 1];
-                
-                if (d1 < d0) {
-                    // Reverse segment [i+1, j]
-                    int a = i + 1;
-                    int b = j;
-                    while (a < b) {
-                        int tmp = ind->active_ring[a];
-                        ind->active_ring[a] = ind->active_ring[b];
-                        ind->active_ring[b] = tmp;
-                        a++;
-                        b--;
-                    }
-                    improved = 1;
-                }
+        for (int i = 0; i + 2 < m; i++) {
+            // (a, b) = slot i, (c, d) = slot j; j = m - 1 closes on slot 0
+            int j_to = (i == 0) ? m - 2 : m - 1;
+            if (j_to < i + 2) continue;
+
+            int a = ids[i], b = ids[i + 1];
+            int j;
+            cost_t gain = best_partner(dist, ids, edge, a, b, edge[i], i + 2, j_to, &j);
+            if (gain <= 0) continue;
+
+            int c = ids[j], d = ids[j + 1];
+            cost_t removed = edge[i] + edge[j];
+            cost_t d_ac = DIST(dist, a, c);
+            cost_t d_bd = DIST(dist, b, d);
+            if (!COST_IMPROVES(d_ac + d_bd, removed)) continue;
+
+            if (ind->cached_cost < 1e17) {
+                ind->cached_cost += alpha * (d_ac + d_bd - removed);
             }
+
+            // Reverse slots i + 1 .. j (ids, ring, inner edges)
+            for (int l = i + 1, r = j; l < r; l++, r--) {
+                int t = ids[l]; ids[l] = ids[r]; ids[r] = t;
+            }
+            for (int l = i + 1, r = j - 1; l < r; l++, r--) {
+                cost_t t = edge[l]; edge[l] = edge[r]; edge[r] = t;
+            }
+            edge[i] = d_ac;
+            edge[j] = d_bd;
+            for (int k = i + 1; k <= j; k++) ind->active_ring[k] = (gene_t)(ids[k] + 1);
+            Individual_SyncPositions(ind, i + 1, j);
+
+            moves++;
+            improved = 1;
         }
     }
+
+    if (borrowed) ind->position = NULL;
+    Workspace_Free(temp);
+    return moves;
 }
@@ -3,17 +3,54 @@
 #define TWOOPT_H
 
 #include "core\Individual.h"
+#include "utils\Ranking.h"
+#include "utils\Workspace.h"
+#include <time.h>
 
-// 2-opt local search on active_ring (alpha-weighted)
-void TwoOptImproveAlpha(
+// Rings of at least this many stations are searched on the workspace
+// two-level list (O(sqrt(m)) reversals) instead of the array
+#define TWO_OPT_LIST_MIN_RING 2000
+
+// 2-opt local search on active_ring (alpha-weighted), restricted to the
+// ranking candidates of each node, with don't-look bits
+// Both modes keep a valid ind->cached_cost and position index up to date
+// move by move, and return the number of moves applied. ws may be NULL
+// (temporary workspace).
+int TwoOptImproveAlpha(
     Individual* ind,
     int alpha,
-    const double** dist,
-    const int** ranking);
+    const DistMatrix* dist,
+    const Ranking* ranking,
+    Workspace* ws);
+
+// Reverse the cyclic slot range [i, j], or its complement when shorter
+// (same tour, opposite direction), keeping the position index in sync.
+// Calling it again with the same range undoes it.
+void TwoOptReverse(Individual* ind, int i, int j);
 
 // 2-Opt EXHAUSTIF : continue jusqu' convergence complte
 // Utilis pour l'initialisation de la population (plus lent mais meilleure qualit)
-void TwoOptExhaustive(Individual* ind, int alpha, const double** dist, const int** ranking);
+int TwoOptExhaustive(Individual* ind, int alpha, const DistMatrix* dist, const Ranking* ranking,
+                     Workspace* ws);
+
+// Same, stopping between two queue pops once clock() reaches deadline (0: no
+// limit)
+int TwoOptExhaustiveUntil(Individual* ind, int alpha, const DistMatrix* dist,
+                          const Ranking* ranking, Workspace* ws, clock_t deadline);
+
+// Exhaustive mode on a path: the closing edge (ring[m - 1], ring[0]) is
+// never broken, so the ring stays that path (maybe rotated or reversed).
+// Used on the slices of a partitioned ring (local_search/Partition.h).
+// Stops once clock() reaches deadline (0: no limit).
+int TwoOptPath(Individual* ind, int alpha, const DistMatrix* dist, const Ranking* ranking,
+               Workspace* ws, clock_t deadline);
+
+// Best-improvement 2-opt over every slot pair (no neighbor lists): for each
+// slot i the gains of all partners are computed with AVX2 gathers in the
+// distance matrix and the best one is applied; sweeps until none improves.
+// O(m^2) per sweep: a finisher for moves the candidate lists cannot see.
+// Returns the number of moves applied.
+int TwoOptBestImprovement(Individual* ind, int alpha, const DistMatrix* dist, Workspace* ws);
 
 #endif
 
@@ -0,0 +1,146 @@
+// local_search/Vnd.c
+// Implementation of the Variable Neighborhood Descent driver
+
+#include "Vnd.h"
+#include "local_search\TwoOpt.h"
+#include "local_search\OrOpt.h"
+#include "local_search\LinKernighan.h"
+#include "local_search\MaskLocalSearch.h"
+#include <string.h>
+#include <time.h>
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+void Vnd_ChildConfig(VndConfig* config)
+{
+    config->count = 2;
+    config->order[0] = VND_TWO_OPT;
+    config->order[1] = VND_OR_OPT;
+    config->exhaustive = 0;
+    config->max_steps = 3;
+    config->max_ms = 0;
+}
+
+void Vnd_InitConfig(VndConfig* config)
+{
+    config->count = 3;
+    config->order[0] = VND_TWO_OPT;
+    config->order[1] = VND_OR_OPT;
+    config->order[2] = VND_LIN_KERNIGHAN;
+    config->exhaustive = 1;
+    config->max_steps = 6;  // LK once, then 2-opt and Or-opt again
+    config->max_ms = 0;     // Set from the time limit (Apply_TwoOpt_To_Population)
+}
+
+void Vnd_EliteConfig(VndConfig* config)
+{
+    config->count = 2;
+    config->order[0] = VND_MASK;
+    config->order[1] = VND_LIN_KERNIGHAN;
+    config->exhaustive = 1;
+    config->max_steps = 2;
+    config->max_ms = VND_ELITE_MS;
+}
+
+static const struct {
+    const char* name;
+    VndNeighborhood neighborhood;
+} NEIGHBORHOOD_NAMES[] = {
+    { "2opt",     VND_TWO_OPT },
+    { "2optfull", VND_TWO_OPT_FULL },
+    { "oropt",    VND_OR_OPT },
+    { "lk",       VND_LIN_KERNIGHAN },
+    { "mask",     VND_MASK }
+};
+
+#define NUM_NEIGHBORHOOD_NAMES (int)(sizeof(NEIGHBORHOOD_NAMES) / sizeof(NEIGHBORHOOD_NAMES[0]))
+
+int Vnd_ParseOrder(VndConfig* config, const char* order)
+{
+    if (!config || !order) return 0;
+
+    VndNeighborhood parsed[VND_MAX_NEIGHBORHOODS];
+    int count = 0;
+    const char* p = order;
+
+    while (*p) {
+        size_t len = strcspn(p, ",");
+        int found = -1;
+        for (int k = 0; k < NUM_NEIGHBORHOOD_NAMES; k++) {
+            if (strlen(NEIGHBORHOOD_NAMES[k].name) == len &&
+                strncmp(p, NEIGHBORHOOD_NAMES[k].name, len) == 0) {
+                found = k;
+                break;
+            }
+        }
+        if (found < 0 || count == VND_MAX_NEIGHBORHOODS) return 0;
+        parsed[count++] = NEIGHBORHOOD_NAMES[found].neighborhood;
+
+        p += len;
+        if (*p == ',') p++;
+    }
+    if (count == 0) return 0;
+
+    config->count = count;
+    for (int k = 0; k < count; k++) config->order[k] = parsed[k];
+    return 1;
+}
+
+// =============================================================================
+// DESCENT
+// =============================================================================
+
+static int apply_neighborhood(VndNeighborhood neighborhood, int exhaustive,
+                              Individual* ind, int alpha, int total_stations,
+                              const DistMatrix* dist, const Ranking* ranking,
+                              Workspace* ws, clock_t deadline)
+{
+    switch (neighborhood) {
+    case VND_TWO_OPT:
+        return exhaustive ? TwoOptExhaustiveUntil(ind, alpha, dist, ranking, ws, deadline)
+                          : TwoOptImproveAlpha(ind, alpha, dist, ranking, ws);
+    case VND_TWO_OPT_FULL:
+        return TwoOptBestImprovement(ind, alpha, dist, ws);
+    case VND_OR_OPT:
+        return exhaustive ? OrOptExhaustiveUntil(ind, alpha, dist, ranking, ws, deadline)
+                          : OrOptImproveAlpha(ind, alpha, dist, ranking, ws);
+    case VND_LIN_KERNIGHAN:
+        return LinKernighanUntil(ind, alpha, dist, ranking, ws, deadline);
+    case VND_MASK:
+        return ImproveMaskLocalUntil(ind, alpha, total_stations, dist, ranking, ws, deadline);
+    }
+    return 0;
+}
+
+int Vnd_Run(Individual* ind, int alpha, int total_stations,
+            const DistMatrix* dist, const Ranking* ranking,
+            const VndConfig* config, Workspace* ws)
+{
+    if (!ind || !dist || !ranking || !config || ind->ring_size < 3) return 0;
+
+    clock_t deadline = 0;
+    if (config->max_ms > 0) {
+        deadline = clock() + (clock_t)((double)config->max_ms * CLOCKS_PER_SEC / 1000.0);
+    }
+
+    int moves = 0;
+    int steps = 0;
+    int k = 0;
+    while (k < config->count) {
+        if (config->max_steps > 0 && steps >= config->max_steps) break;
+        if (deadline && clock() >= deadline) break;
+
+        int applied = apply_neighborhood(config->order[k], config->exhaustive,
+                                         ind, alpha, total_stations, dist, ranking, ws,
+                                         deadline);
+        steps++;
+        moves += applied;
+
+        // Back to the first neighborhood after an improvement (the one that
+        // just converged is not run again right away)
+        k = (applied > 0 && k > 0) ? 0 : k + 1;
+    }
+    return moves;
+}
@@ -0,0 +1,72 @@
+// local_search/Vnd.h
+// Variable Neighborhood Descent over the local search operators
+//
+// The neighborhoods of a config are tried in order: when one improves the
+// individual the descent goes back to the first (cheapest) one, otherwise it
+// moves on to the next. It stops when the last one fails, or when the step
+// budget (neighborhood calls) or the time budget of the call runs out (the
+// exhaustive 2-opt and Or-opt, the membership search and LK also check it
+// inside a call). Cheap
+// neighborhoods do most of the work; expensive ones only run at their local
+// optima.
+//
+// Neighborhoods, by name (Vnd_ParseOrder):
+//   2opt    2-opt (local_search/TwoOpt.h)
+//   2optfull  Best-improvement 2-opt over all slot pairs (same header)
+//   oropt   Segment relocation (local_search/OrOpt.h)
+//   lk      Lin-Kernighan chains (local_search/LinKernighan.h)
+//   mask    Ring membership add/drop/swap (local_search/MaskLocalSearch.h)
+//
+// Keeps a valid ind->cached_cost and position index up to date.
+// ws may be NULL (temporary workspace).
+
+#ifndef VND_H
+#define VND_H
+
+#include "core\Individual.h"
+#include "utils\Ranking.h"
+#include "utils\Workspace.h"
+
+#define VND_MAX_NEIGHBORHOODS 8
+
+typedef enum {
+    VND_TWO_OPT,
+    VND_TWO_OPT_FULL,
+    VND_OR_OPT,
+    VND_LIN_KERNIGHAN,
+    VND_MASK
+} VndNeighborhood;
+
+typedef struct {
+    int count;
+    VndNeighborhood order[VND_MAX_NEIGHBORHOODS];
+    int exhaustive;     // 2-opt / Or-opt on every node (else adaptive window)
+    int max_steps;      // Neighborhood calls per run (0: no limit)
+    int max_ms;         // Time per run in milliseconds (0: no limit)
+} VndConfig;
+
+// Time budget of the elite polish in milliseconds (Vnd_EliteConfig)
+#define VND_ELITE_MS 20
+
+// Share of the run time limit the initial population search may use (a
+// deadline for the whole phase, generation/PopulationInit.h)
+#define VND_INIT_TIME_SHARE 0.1
+
+// Presets: adaptive 2-opt then Or-opt for each child (3 steps), exhaustive
+// 2-opt, Or-opt and LK for the initial population (6 steps; membership is
+// left out, it is the slowest on random rings), membership then LK on the
+// best elite of each species (two steps, VND_ELITE_MS)
+void Vnd_ChildConfig(VndConfig* config);
+void Vnd_InitConfig(VndConfig* config);
+void Vnd_EliteConfig(VndConfig* config);
+
+// Replace the order of config with a comma separated list of names, e.g.
+// "2opt,oropt,mask". Returns 0 (config unchanged) on an unknown or empty list.
+int Vnd_ParseOrder(VndConfig* config, const char* order);
+
+// Run the descent on ind, returns the number of moves applied
+int Vnd_Run(Individual* ind, int alpha, int total_stations,
+            const DistMatrix* dist, const Ranking* ranking,
+            const VndConfig* config, Workspace* ws);
+
+#endif // VND_H
@@ -10,13 +10,20 @@
 
 #include "core\Node.h"
 #include "core\Individual.h"
+#include "core\Assignment.h"
 #include "generation\PopulationInit.h"
 #include "utils\Distance.h"
+#include "utils\Ranking.h"
 #include "utils\Random.h"
 #include "utils\ThreadPool.h"
+#include "utils\Workspace.h"
 #include "utils\Visualize.h"
 #include "evolution\EvolveSpecie.h"
+#include "evolution\Trajectory.h"
+#include "local_search\Vnd.h"
 #include "cost\Cost.h"
+#include "cost\FitnessCache.h"
+#include "cost\LowerBound.h"
 #include "genetic\Selection.h"
 #include "utils\FileIO.h"
 #include "utils\hierarchy_and_print_utils.h"
@@ -112,12 +119,25 @@ int main(int argc, char** argv)
     int num_threads = 0;
     int enable_logs = 0;
     int enable_timers = 0;
+    int k_nearest = RANKING_DEFAULT_K;
+    int matrix_free = 0;
+    int memo_log2 = FITNESS_CACHE_DEFAULT_LOG2;
+    double gap_target = 0.0;    // Percent, 0 = run until the time limit
+    VndConfig vnd_child, vnd_init;  // Local search on children / initial rings
+    VndConfig vnd_elite;            // Polish of the best elite of each species
+    Vnd_ChildConfig(&vnd_child);
+    Vnd_InitConfig(&vnd_init);
+    Vnd_EliteConfig(&vnd_elite);
+    EngineConfig engines;           // Engine of each species, in turn
+    Engine_DefaultConfig(&engines);
 
     // -------------------------------------------------------------------------
     // PARSE COMMAND LINE (optional overrides)
     // -------------------------------------------------------------------------
     parse_args(argc, argv, &max_generations, &log_interval, &num_species,
-               &pop_size, &num_threads, &verbose, &enable_logs, &enable_timers);
+               &pop_size, &num_threads, &verbose, &enable_logs, &enable_timers,
+               &k_nearest, &matrix_free, &memo_log2, &gap_target,
+               &vnd_child, &vnd_init, &vnd_elite, &engines);
 
     // Recalculate elitism after pop_size might have changed
     elitism = (pop_size * 5) / 100;
@@ -138,6 +158,11 @@ int main(int argc, char** argv)
     printf("  Species:     %d\n", num_species);
     printf("  Population:  %d per species\n", pop_size);
     printf("  Elitism:     %d (top individuals preserved)\n", elitism);
+    printf("  Engines:     ");
+    for (int k = 0; k < engines.count; k++) {
+        printf("%s%s", k ? "," : "", Engine_Name(engines.list[k]));
+    }
+    printf(" (species in turn)\n");
     printf("  Threads:     %d\n\n", num_threads);
 
     // -------------------------------------------------------------------------
@@ -152,6 +177,13 @@ int main(int argc, char** argv)
         fprintf(stderr, "ERROR: Failed to load dataset '%s'\n", dataset_path);
         return 1;
     }
+    if (total_stations > GENE_MAX_STATIONS) {
+        fprintf(stderr, "ERROR: %d stations exceed the gene id range (%d), "
+                        "rebuild with WIDE_IDS\n",
+                total_stations, GENE_MAX_STATIONS);
+        free(nodes);
+        return 1;
+    }
     printf("         %d stations loaded\n\n", total_stations);
 
     // -------------------------------------------------------------------------
@@ -161,7 +193,15 @@ int main(int argc, char** argv)
     
     Timer t;
     timer_start(&t);
-    double** dist = Compute_Distances_2DVector(nodes, total_stations);
+    DistMatrix* dist;
+    if (matrix_free) {
+        // Coordinates only: a full ranking would bring back the N^2 memory
+        if (k_nearest <= 0) k_nearest = RANKING_DEFAULT_K;
+        printf("         Matrix-free mode (distances computed on the fly)\n");
+        dist = DistMatrix_CreateMatrixFree(nodes, total_stations);
+    } else {
+        dist = DistMatrix_Create(nodes, total_stations);
+    }
     
     if (!dist) {
         fprintf(stderr, "ERROR: Distance computation failed\n");
@@ -176,15 +216,27 @@ int main(int argc, char** argv)
     printf("[STEP 3] Computing distance ranking...\n");
     
     timer_start(&t);
-    int** ranking = Distance_Ranking_2DVector(dist, total_stations, total_stations);
+    Ranking* ranking = Ranking_Create(dist, total_stations, k_nearest);
     
     if (!ranking) {
         fprintf(stderr, "ERROR: Ranking computation failed\n");
-        Free_2DArray_Double(dist, total_stations);
+        DistMatrix_Free(dist);
         free(nodes);
         return 1;
     }
-    printf("         Done (%.1f ms)\n\n", timer_ms(&t));
+    printf("         %d nearest per station (%.1f ms)\n\n", ranking->k, timer_ms(&t));
+
+    // Lower bound: computed by a background thread while the population is
+    // built, refined during the run
+    LowerBound* lower_bound = LowerBound_Start(alpha, total_stations, dist, ranking);
+    if (!lower_bound) {
+        printf("[WARNING] Lower bound unavailable, no gap reporting\n\n");
+    }
+
+    // Shared fitness memo (before any evaluation)
+    if (FitnessCache_Init(memo_log2) != 0) {
+        printf("[WARNING] Fitness memo allocation failed, running without it\n\n");
+    }
 
     // -------------------------------------------------------------------------
     // STEP 4: INITIALIZE POPULATION
@@ -200,36 +252,66 @@ int main(int argc, char** argv)
     
     if (!species) {
         fprintf(stderr, "ERROR: Population initialization failed\n");
-        Free_2DArray_Int(ranking, total_stations);
-        Free_2DArray_Double(dist, total_stations);
+        LowerBound_Stop(lower_bound);
+        Ranking_Free(ranking);
+        DistMatrix_Free(dist);
         free(nodes);
         return 1;
     }
     printf("         %d species x %d individuals (%.1f ms)\n", 
            num_species, pop_size, timer_ms(&t));
 
-    // -------------------------------------------------------------------------
-    // STEP 4b: APPLY 2-OPT TO PART OF INITIAL POPULATION
-    // -------------------------------------------------------------------------
-    printf("         Applying 2-Opt (exhaustive) to 20%% of species...\n");
-    timer_start(&t);
-    
-    Apply_TwoOpt_To_Population(species, num_species, pop_size, alpha,
-                               (const double**)dist, (const int**)ranking);
-    
-    printf("         Done (%.1f ms)\n\n", timer_ms(&t));
+    // Species arenas: every ring buffer and scratch of the run, allocated once
+    SpeciesArena** arenas = (SpeciesArena**)calloc(num_species, sizeof(SpeciesArena*));
+    size_t arena_bytes = 0;
+    int arenas_ok = (arenas != NULL);
+    for (int s = 0; arenas_ok && s < num_species; s++) {
+        arenas[s] = SpeciesArena_Create(species[s], pop_size, total_stations);
+        if (!arenas[s]) arenas_ok = 0;
+        arena_bytes += SpeciesArena_Bytes(arenas[s]);
+    }
+    if (!arenas_ok) {
+        fprintf(stderr, "ERROR: Species arena allocation failed\n");
+        for (int s = 0; arenas && s < num_species; s++) {
+            SpeciesArena_Free(arenas[s], species[s]);
+        }
+        free(arenas);
+        Free_Population(species, num_species, pop_size);
+        LowerBound_Stop(lower_bound);
+        Ranking_Free(ranking);
+        DistMatrix_Free(dist);
+        free(nodes);
+        return 1;
+    }
+    printf("         Species arenas: %.1f MB\n\n", arena_bytes / (1024.0 * 1024.0));
 
     // -------------------------------------------------------------------------
     // STEP 5: CREATE THREAD POOL
     // -------------------------------------------------------------------------
     printf("[STEP 5] Creating thread pool...\n");
     
-    int pool_ok = ThreadPool_Init(num_threads);
+    int pool_ok = ThreadPool_Init(num_threads, total_stations);
     if (!pool_ok) {
         fprintf(stderr, "WARNING: Thread pool failed, using single thread\n");
         num_threads = 0;
     }
-    printf("         %d worker threads ready\n\n", num_threads);
+    printf("         %d worker threads ready\n", num_threads);
+
+    // -------------------------------------------------------------------------
+    // STEP 5b: APPLY LOCAL SEARCH TO PART OF INITIAL POPULATION
+    // (after the pool: the individuals and large rings are spread over it)
+    // -------------------------------------------------------------------------
+    printf("         Applying VND (exhaustive) to 20%% of species...\n");
+    timer_start(&t);
+    
+    Apply_TwoOpt_To_Population(species, num_species, pop_size, alpha,
+                               dist, ranking, &vnd_init,
+                               (int)(time_limit_seconds * 1000.0 * VND_INIT_TIME_SHARE));
+    
+    printf("         Done (%.1f ms)\n\n", timer_ms(&t));
+
+    // Serial mode: the main thread evolves the species with its own scratch
+    Workspace* serial_ws = (num_threads == 0) ? Workspace_Create(total_stations) : NULL;
 
     // Pre-allocate task array
     EvolveTask* tasks = (EvolveTask*)malloc(num_species * sizeof(EvolveTask));
@@ -240,14 +322,15 @@ int main(int argc, char** argv)
     printf("[STEP 6] Starting evolution (time limit: %.1f s)...\n", time_limit_seconds);
     printf("============================================\n\n");
 
-    double best_cost = 1e18;
+    cost_t best_cost = 1e18;
     int stagnation = 0;
     int stagnation_limit = 50;
     int gen = 0;
     int visualization_done = 0;  // Flag pour ne visualiser qu'une seule fois
+    int gap_reached = 0;
 
     // Pour dtecter les espces avec le mme score
-    double* species_best_costs = (double*)malloc(num_species * sizeof(double));
+    cost_t* species_best_costs = (cost_t*)malloc(num_species * sizeof(cost_t));
     int* species_stagnation = (int*)calloc(num_species, sizeof(int));  // Compteur de stagnation par espce
 
     // Evolution loop - stops when time limit is reached
@@ -257,8 +340,11 @@ int main(int argc, char** argv)
         for (int s = 0; s < num_species; s++) {
             tasks[s].specie = species[s];
             tasks[s].pop_size = pop_size;
+            tasks[s].arena = arenas[s];
             tasks[s].dist = dist;
             tasks[s].ranking = ranking;
+            tasks[s].local_search = &vnd_child;
+            tasks[s].elite_search = &vnd_elite;
             tasks[s].nodes = nodes;
             tasks[s].total_stations = total_stations;
             tasks[s].alpha = alpha;
@@ -269,6 +355,7 @@ int main(int argc, char** argv)
             tasks[s].swap_pct = swap_pct;
             tasks[s].inv_pct = inv_pct;
             tasks[s].scr_pct = scr_pct;
+            tasks[s].engine = engines.list[s % engines.count];
         }
 
         // Execute evolution (parallel or serial)
@@ -276,17 +363,7 @@ int main(int argc, char** argv)
             ThreadPool_Run(tasks, num_species, enable_logs, enable_timers);
         } else {
             for (int s = 0; s < num_species; s++) {
-                EvolveTask* tk = &tasks[s];
-                EvolveSpecie(
-                    tk->specie, tk->pop_size,
-                    (const double**)tk->dist, (const int**)tk->ranking,
-                    tk->nodes, tk->total_stations,
-                    tk->alpha, tk->total_stations,
-                    tk->mutation_rate, tk->elitism,
-                    tk->add_pct, tk->remove_pct, tk->swap_pct,
-                    tk->inv_pct, tk->scr_pct, 0.5,
-                    enable_logs, enable_timers
-                );
+                EvolveTask_Execute(&tasks[s], serial_ws, enable_logs, enable_timers);
             }
         }
 
@@ -298,16 +375,16 @@ int main(int argc, char** argv)
         if (gen > 0 && gen % 10 == 0) {
             // Calculer le meilleur cot de chaque espce
             for (int s = 0; s < num_species; s++) {
-                double* costs = Total_Cost_Specie(alpha, species[s], pop_size,
+                cost_t* costs = Total_Cost_Specie(alpha, species[s], pop_size,
                                                   total_stations,
-                                                  (const double**)dist,
-                                                  (const int**)ranking);
+                                                  dist,
+                                                  ranking);
                 if (costs) {
                     int idx = Select_Best(costs, pop_size);
-                    double new_best = costs[idx];
+                    cost_t new_best = costs[idx];
                     
                     // Vrifier si l'espce stagne
-                    if (fabs(new_best - species_best_costs[s]) < 0.01) {
+                    if (COST_EQUAL(new_best, species_best_costs[s])) {
                         species_stagnation[s]++;
                     } else {
                         species_stagnation[s] = 0;
@@ -316,28 +393,43 @@ int main(int argc, char** argv)
                     free(costs);
                 }
             }
+
+            // Optimality gap: early stop once the target is reached
+            if (lower_bound) {
+                cost_t gen_best = species_best_costs[0];
+                for (int s = 1; s < num_species; s++) {
+                    if (species_best_costs[s] < gen_best) gen_best = species_best_costs[s];
+                }
+                LowerBound_SetUpperBound(lower_bound, (double)gen_best);
+                double gap = 100.0 * LowerBound_Gap(lower_bound, (double)gen_best);
+                if (gap_target > 0 && gap <= gap_target) {
+                    printf("[GAP] %.2f%% <= target %.2f%% at generation %d\n",
+                           gap, gap_target, gen);
+                    gap_reached = 1;
+                    gen++;
+                    break;
+                }
+            }
             
             // Trouver les espces avec des cots EXACTEMENT GAUX
             for (int s1 = 0; s1 < num_species; s1++) {
                 for (int s2 = s1 + 1; s2 < num_species; s2++) {
-                    double diff = fabs(species_best_costs[s1] - species_best_costs[s2]);
+                    int equal = COST_EQUAL(species_best_costs[s1], species_best_costs[s2]);
                     
-                    // Cots GAUX (tolrance pour erreurs floating point: < 0.01)
+                    // Cots GAUX (COST_EQUAL : exact en mode entier, tolrance 0.01 sinon)
                     // ET les deux espces stagnent depuis > 5 vrifications
-                    if (diff < 0.01 && 
+                    if (equal && 
                         species_stagnation[s1] > 5 && species_stagnation[s2] > 5) {
                         
                         // Rinitialiser s2 (garder s1)
                         int to_reset = s2;
                         
                         printf("[DIVERSITY] Species %d and %d have EQUAL cost (%.2f) - resetting species %d\n",
-                               s1, s2, species_best_costs[s1], to_reset);
+                               s1, s2, (double)species_best_costs[s1], to_reset);
                         
                         // Rinitialiser tous les individus de cette espce
+                        // Rings are rewritten in place (arena slots)
                         for (int i = 0; i < pop_size; i++) {
-                            Individual_Free(&species[to_reset][i]);
-                            Individual_Init(&species[to_reset][i], total_stations);
-                            
                             // Crer un nouveau ring alatoire
                             int ring_size = RandInt(2, total_stations);
                             int* all_ids = (int*)malloc(total_stations * sizeof(int));
@@ -358,6 +450,7 @@ int main(int argc, char** argv)
                             }
                             free(all_ids);
                             species[to_reset][i].cached_cost = 1e18;
+                            Individual_RebuildPositions(&species[to_reset][i]);
                         }
                         
                         species_stagnation[to_reset] = 0;
@@ -376,7 +469,7 @@ int main(int argc, char** argv)
                 gen, num_species, pop_size, dist, ranking,
                 nodes, total_stations, alpha, species,
                 &best_cost, &stagnation, &mutation_rate,
-                enable_logs, enable_timers
+                enable_logs, enable_timers, lower_bound
             );
             
             // Show remaining time
@@ -389,14 +482,14 @@ int main(int argc, char** argv)
                 printf("\n[STAGNATION] Reached %d - generating visualization...\n", stagnation);
                 
                 // Find the best individual for visualization
-                double viz_best_cost = 1e18;
+                cost_t viz_best_cost = 1e18;
                 int viz_best_species = 0, viz_best_idx = 0;
                 
                 for (int s = 0; s < num_species; s++) {
-                    double* costs = Total_Cost_Specie(alpha, species[s], pop_size,
+                    cost_t* costs = Total_Cost_Specie(alpha, species[s], pop_size,
                                                       total_stations,
-                                                      (const double**)dist,
-                                                      (const int**)ranking);
+                                                      dist,
+                                                      ranking);
                     if (costs) {
                         int idx = Select_Best(costs, pop_size);
                         if (costs[idx] < viz_best_cost) {
@@ -410,7 +503,8 @@ int main(int argc, char** argv)
                 
                 // Generate visualization (only once)
                 Visualize_Ring(&species[viz_best_species][viz_best_idx], nodes, 
-                              total_stations, viz_best_cost, alpha, gen);
+                              total_stations, viz_best_cost, alpha, gen,
+                              dist, ranking);
                 
                 visualization_done = 1;  // Ne plus visualiser aprs
                 
@@ -427,7 +521,8 @@ int main(int argc, char** argv)
     free(species_best_costs);
     free(species_stagnation);
 
-    printf("\n[TIME LIMIT] Stopped after %.1f seconds (%d generations)\n\n", 
+    printf("\n[%s] Stopped after %.1f seconds (%d generations)\n\n", 
+           gap_reached ? "GAP TARGET" : "TIME LIMIT",
            timer_seconds(&total_timer), gen);
 
     // -------------------------------------------------------------------------
@@ -436,14 +531,14 @@ int main(int argc, char** argv)
     printf("============================================\n");
     printf("[STEP 7] Final evaluation\n\n");
 
-    double final_best = 1e18;
+    cost_t final_best = 1e18;
     int best_species = 0, best_idx = 0;
 
     for (int s = 0; s < num_species; s++) {
-        double* costs = Total_Cost_Specie(alpha, species[s], pop_size,
+        cost_t* costs = Total_Cost_Specie(alpha, species[s], pop_size,
                                           total_stations,
-                                          (const double**)dist,
-                                          (const int**)ranking);
+                                          dist,
+                                          ranking);
         if (costs) {
             int idx = Select_Best(costs, pop_size);
             if (costs[idx] < final_best) {
@@ -457,7 +552,7 @@ int main(int argc, char** argv)
 
     printf("  BEST SOLUTION\n");
     printf("  -------------\n");
-    printf("  Cost:    %.2f\n", final_best);
+    printf("  Cost:    %.2f\n", (double)final_best);
     printf("  Species: %d\n", best_species);
     printf("  Index:   %d\n", best_idx);
     
@@ -472,28 +567,46 @@ int main(int argc, char** argv)
     // -------------------------------------------------------------------------
     // FINAL VISUALIZATION (at end of timer)
     // -------------------------------------------------------------------------
+    // Build the assignment cache once: shared by the visualization and the writer
+    Assignment_Attach(best, total_stations, dist, ranking);
+
     printf("[FINAL VISUALIZATION] Generating final result image...\n");
-    Visualize_Ring(best, nodes, total_stations, final_best, alpha, gen);
+    Visualize_Ring(best, nodes, total_stations, final_best, alpha, gen,
+                   dist, ranking);
 
     // -------------------------------------------------------------------------
     // WRITE SOLUTION TO FILE
     // -------------------------------------------------------------------------
     printf("\n[WRITING SOLUTION] Creating Genetic_Solution.txt...\n");
     WriteSolutionToFile(best, total_stations, alpha, final_best, 
-                       (const int**)ranking);
+                       dist, ranking);
 
     // -------------------------------------------------------------------------
     // STEP 8: CLEANUP
     // -------------------------------------------------------------------------
     printf("\n[STEP 8] Cleanup...\n");
 
+    // The bound thread reads the matrix and ranking: stop it first
+    double final_bound = LowerBound_Get(lower_bound);
+    LowerBound_SetUpperBound(lower_bound, (double)final_best);
+    double final_gap = LowerBound_Gap(lower_bound, (double)final_best);
+    LowerBound_Stop(lower_bound);
+
     ThreadPool_Destroy();
+    Workspace_Free(serial_ws);
     free(tasks);
+    for (int s = 0; s < num_species; s++) {
+        SpeciesArena_Free(arenas[s], species[s]);
+    }
+    free(arenas);
     Free_Population(species, num_species, pop_size);
-    Free_2DArray_Int(ranking, total_stations);
-    Free_2DArray_Double(dist, total_stations);
+    Ranking_Free(ranking);
+    DistMatrix_Free(dist);
     free(nodes);
 
+    FitnessCacheStats memo = FitnessCache_GetStats();
+    FitnessCache_Shutdown();
+
     printf("         Done\n\n");
 
     // -------------------------------------------------------------------------
@@ -502,7 +615,15 @@ int main(int argc, char** argv)
     printf("============================================\n");
     printf("  DATASET: %d stations (alpha=%d)\n", total_stations, alpha);
     printf("  GENERATIONS: %d\n", gen);
-    printf("  BEST COST: %.2f\n", final_best);
+    printf("  BEST COST: %.2f\n", (double)final_best);
+    if (final_bound > 0) {
+        printf("  LOWER BOUND: %.2f (gap %.2f%%)\n", final_bound, 100.0 * final_gap);
+    }
+    if (memo.slots > 0) {
+        long long lookups = memo.hits + memo.misses;
+        printf("  FITNESS MEMO: %lld hits / %lld lookups (%.1f%% evaluations saved)\n",
+               memo.hits, lookups, lookups ? 100.0 * memo.hits / lookups : 0.0);
+    }
     printf("  TOTAL TIME: %.1f seconds\n", timer_seconds(&total_timer));
     printf("============================================\n");
 
@@ -0,0 +1,120 @@
+// utils/Bitset.c
+// Implementation of the packed membership set and the scan kernel
+
+#include "Bitset.h"
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+int Bitset_LowestBit(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+#if defined(__AVX2__)
+// Lanes of 'ids' whose bit is set, as an 8-bit movemask: gather the words,
+// shift each bit down to position 0 and compare with 1
+static int member_mask(const uint32_t* bits, __m256i ids)
+{
+    const __m256i low5 = _mm256_set1_epi32(31);
+    const __m256i one = _mm256_set1_epi32(1);
+
+    __m256i words = _mm256_i32gather_epi32(
+        (const int*)bits, _mm256_srli_epi32(ids, 5), 4);
+    __m256i bit = _mm256_and_si256(
+        _mm256_srlv_epi32(words, _mm256_and_si256(ids, low5)), one);
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(bit, one)));
+}
+#endif
+
+// =============================================================================
+// SET OPERATIONS
+// =============================================================================
+
+void Bitset_Clear(uint32_t* bits, int max_id)
+{
+    memset(bits, 0, BITSET_WORDS(max_id) * sizeof(uint32_t));
+}
+
+void Bitset_FromRing(uint32_t* bits, int max_id, const gene_t* ring, int ring_size)
+{
+    Bitset_Clear(bits, max_id);
+    for (int i = 0; i < ring_size; ++i) {
+        int id = ring[i];
+        if (id > 0 && id <= max_id) BITSET_SET(bits, id);
+    }
+}
+
+int Bitset_Next(const uint32_t* bits, int max_id, int from)
+{
+    if (from < 0) from = 0;
+    if (from > max_id) return -1;
+
+    int w = from >> 5;
+    int words = BITSET_WORDS(max_id);
+    uint32_t word = bits[w] & (~0u << (from & 31));
+
+    while (!word) {
+        if (++w >= words) return -1;
+        word = bits[w];
+    }
+
+    int id = (w << 5) + Bitset_LowestBit(word);
+    return (id <= max_id) ? id : -1;
+}
+
+// =============================================================================
+// SCAN KERNELS
+// =============================================================================
+
+int Bitset_FirstInRow(const uint32_t* bits, const int32_t* row, int from, int len)
+{
+    int j = from;
+
+#if defined(__AVX2__)
+    for (; j + 8 <= len; j += 8) {
+        __m256i ids = _mm256_loadu_si256((const __m256i*)(row + j));
+        int mask = member_mask(bits, ids);
+        if (mask) return j + Bitset_LowestBit((unsigned int)mask);
+    }
+#endif
+
+    // Scalar path (tail of the row, or whole row without AVX2)
+    for (; j < len; ++j) {
+        if (BITSET_TEST(bits, row[j])) return j;
+    }
+    return -1;
+}
+
+int Bitset_FirstInRow16(const uint32_t* bits, const uint16_t* row, int from, int len)
+{
+    int j = from;
+
+#if defined(__AVX2__)
+    for (; j + 8 <= len; j += 8) {
+        __m256i ids = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(row + j)));
+        int mask = member_mask(bits, ids);
+        if (mask) return j + Bitset_LowestBit((unsigned int)mask);
+    }
+#endif
+
+    for (; j < len; ++j) {
+        if (BITSET_TEST(bits, row[j])) return j;
+    }
+    return -1;
+}
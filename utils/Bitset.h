@@ -0,0 +1,45 @@
+// utils/Bitset.h
+// Packed station membership set and nearest-active scan kernel
+//
+// A ring is described by one bit per station id (1-indexed, bit 0 unused):
+// 32x smaller than an int array, so the set stays in L1 cache even for
+// multi-thousand-station instances and clearing it is a few words.
+//
+// Bitset_FirstInRow is the hot loop of every out-of-ring evaluation: it
+// scans a ranking row until it meets a station of the set. With AVX2
+// (MSVC /arch:AVX2, GCC/Clang -mavx2) it tests 8 candidates per step with
+// a gather; otherwise a scalar loop is used.
+
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <stdint.h>
+#include "core\GeneType.h"
+
+// Number of 32-bit words needed for ids 0..max_id
+#define BITSET_WORDS(max_id) (((max_id) >> 5) + 1)
+
+#define BITSET_TEST(bits, id)  (((bits)[(id) >> 5] >> ((id) & 31)) & 1u)
+#define BITSET_SET(bits, id)   ((bits)[(id) >> 5] |= (1u << ((id) & 31)))
+#define BITSET_CLEAR(bits, id) ((bits)[(id) >> 5] &= ~(1u << ((id) & 31)))
+
+// Clear the set (ids 0..max_id)
+void Bitset_Clear(uint32_t* bits, int max_id);
+
+// Clear the set, then add every station of the ring with id in [1, max_id]
+void Bitset_FromRing(uint32_t* bits, int max_id, const gene_t* ring, int ring_size);
+
+// Index of the lowest set bit of a non-zero mask
+int Bitset_LowestBit(uint32_t mask);
+
+// Smallest id >= from that belongs to the set, -1 if none (skips empty words)
+int Bitset_Next(const uint32_t* bits, int max_id, int from);
+
+// Index of the first entry of row[from .. len - 1] that belongs to the set,
+// -1 if none. Every entry must be a valid id of the set (0..max_id).
+int Bitset_FirstInRow(const uint32_t* bits, const int32_t* row, int from, int len);
+
+// Same scan over a compact 16-bit row (utils/Ranking.h)
+int Bitset_FirstInRow16(const uint32_t* bits, const uint16_t* row, int from, int len);
+
+#endif // BITSET_H
@@ -1,99 +1,146 @@
 // utils/Distance.c - Pure C implementation
 #include "Distance.h"
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
-typedef struct {
-    double value;
-    int index;
-} DistPair;
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
-static int cmp_dist(const void* a, const void* b)
+// Aligned allocation (size is rounded up to a multiple of the alignment)
+static void* aligned_alloc_bytes(size_t size)
 {
-    double diff = ((DistPair*)a)->value - ((DistPair*)b)->value;
-    if (diff < 0) return -1;
-    if (diff > 0) return 1;
-    return ((DistPair*)a)->index - ((DistPair*)b)->index;
+    size = (size + DIST_ALIGNMENT - 1) / DIST_ALIGNMENT * DIST_ALIGNMENT;
+#ifdef _MSC_VER
+    return _aligned_malloc(size, DIST_ALIGNMENT);
+#else
+    return aligned_alloc(DIST_ALIGNMENT, size);
+#endif
 }
 
-double** Compute_Distances_2DVector(const Node* nodes, int num_nodes)
+static void aligned_free_bytes(void* ptr)
 {
-    double** dist = (double**)malloc(num_nodes * sizeof(double*));
-    if (!dist) return NULL;
-    
-    for (int i = 0; i < num_nodes; ++i) {
-        dist[i] = (double*)malloc(num_nodes * sizeof(double));
-        if (!dist[i]) {
-            Free_2DArray_Double(dist, i);
-            return NULL;
-        }
+#ifdef _MSC_VER
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+// Allocate and fill the structure-of-arrays coordinates. Returns 0 on failure.
+static int fill_coordinates(DistMatrix* m, const Node* nodes)
+{
+    m->xs = (double*)aligned_alloc_bytes((size_t)m->n * sizeof(double));
+    m->ys = (double*)aligned_alloc_bytes((size_t)m->n * sizeof(double));
+    if (!m->xs || !m->ys) return 0;
+
+    for (int i = 0; i < m->n; ++i) {
+        m->xs[i] = nodes[i].x;
+        m->ys[i] = nodes[i].y;
     }
-    
+    return 1;
+}
+
+DistMatrix* DistMatrix_Create(const Node* nodes, int num_nodes)
+{
+    if (!nodes || num_nodes <= 0) return NULL;
+
+    DistMatrix* m = (DistMatrix*)calloc(1, sizeof(DistMatrix));
+    if (!m) return NULL;
+
+    // Pad rows to whole cache lines
+    int per_line = DIST_ALIGNMENT / (int)sizeof(dist_t);
+    m->n = num_nodes;
+    m->stride = (num_nodes + per_line - 1) / per_line * per_line;
+    m->data = (dist_t*)aligned_alloc_bytes((size_t)num_nodes * m->stride * sizeof(dist_t));
+    if (!m->data || !fill_coordinates(m, nodes)) {
+        DistMatrix_Free(m);
+        return NULL;
+    }
+    memset(m->data, 0, (size_t)num_nodes * m->stride * sizeof(dist_t));
+
     for (int i = 0; i < num_nodes; ++i) {
-        dist[i][i] = 0.0;
+        dist_t* row_i = DIST_ROW(m, i);
+        row_i[i] = 0;
         for (int j = i + 1; j < num_nodes; ++j) {
             double dx = nodes[i].x - nodes[j].x;
             double dy = nodes[i].y - nodes[j].y;
-            double d = sqrt(dx * dx + dy * dy);
-            dist[i][j] = d;
-            dist[j][i] = d;
+            dist_t d = DIST_ROUND(sqrt(dx * dx + dy * dy));
+            row_i[j] = d;
+            DIST_ROW(m, j)[i] = d;
         }
     }
     
-    return dist;
+    return m;
 }
 
-int** Distance_Ranking_2DVector(double** dist, int rows, int cols)
+DistMatrix* DistMatrix_CreateMatrixFree(const Node* nodes, int num_nodes)
 {
-    int** ranking = (int**)malloc(rows * sizeof(int*));
-    if (!ranking) return NULL;
-    
-    for (int i = 0; i < rows; ++i) {
-        ranking[i] = (int*)malloc(cols * sizeof(int));
-        if (!ranking[i]) {
-            Free_2DArray_Int(ranking, i);
-            return NULL;
-        }
-    }
-    
-    for (int i = 0; i < rows; ++i) {
-        DistPair* pairs = (DistPair*)malloc(cols * sizeof(DistPair));
-        if (!pairs) {
-            Free_2DArray_Int(ranking, rows);
-            return NULL;
-        }
-        
-        for (int j = 0; j < cols; ++j) {
-            pairs[j].value = dist[i][j];
-            pairs[j].index = j + 1;
-        }
-        
-        qsort(pairs, cols, sizeof(DistPair), cmp_dist);
-        
-        for (int j = 0; j < cols; ++j) {
-            ranking[i][j] = pairs[j].index;
-        }
-        
-        free(pairs);
+    if (!nodes || num_nodes <= 0) return NULL;
+
+    DistMatrix* m = (DistMatrix*)calloc(1, sizeof(DistMatrix));
+    if (!m) return NULL;
+
+    m->n = num_nodes;
+    m->stride = num_nodes;
+    m->data = NULL;
+    if (!fill_coordinates(m, nodes)) {
+        DistMatrix_Free(m);
+        return NULL;
     }
-    
-    return ranking;
+
+    return m;
 }
 
-void Free_2DArray_Double(double** arr, int rows)
+cost_t DistMatrix_Compute(const DistMatrix* m, int a, int b)
 {
-    if (!arr) return;
-    for (int i = 0; i < rows; ++i) {
-        if (arr[i]) free(arr[i]);
-    }
-    free(arr);
+    double dx = m->xs[a] - m->xs[b];
+    double dy = m->ys[a] - m->ys[b];
+    return (cost_t)DIST_ROUND(sqrt(dx * dx + dy * dy));
 }
 
-void Free_2DArray_Int(int** arr, int rows)
+void DistMatrix_FillRow(const DistMatrix* m, int a, dist_t* out)
 {
-    if (!arr) return;
-    for (int i = 0; i < rows; ++i) {
-        if (arr[i]) free(arr[i]);
+    if (m->data) {
+        memcpy(out, DIST_ROW(m, a), (size_t)m->n * sizeof(dist_t));
+        return;
     }
-    free(arr);
+
+    double xa = m->xs[a];
+    double ya = m->ys[a];
+    int j = 0;
+
+#if defined(__AVX2__)
+    const __m256d vx = _mm256_set1_pd(xa);
+    const __m256d vy = _mm256_set1_pd(ya);
+    for (; j + 4 <= m->n; j += 4) {
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(m->xs + j), vx);
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(m->ys + j), vy);
+        __m256d len = _mm256_sqrt_pd(
+            _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+
+        double lanes[4];
+        _mm256_storeu_pd(lanes, len);
+        out[j]     = DIST_ROUND(lanes[0]);
+        out[j + 1] = DIST_ROUND(lanes[1]);
+        out[j + 2] = DIST_ROUND(lanes[2]);
+        out[j + 3] = DIST_ROUND(lanes[3]);
+    }
+#endif
+
+    for (; j < m->n; ++j) {
+        double dx = m->xs[j] - xa;
+        double dy = m->ys[j] - ya;
+        out[j] = DIST_ROUND(sqrt(dx * dx + dy * dy));
+    }
+}
+
+void DistMatrix_Free(DistMatrix* m)
+{
+    if (!m) return;
+    aligned_free_bytes(m->data);
+    aligned_free_bytes(m->xs);
+    aligned_free_bytes(m->ys);
+    free(m);
 }
@@ -1,12 +1,67 @@
 #pragma once
+#include <stddef.h>
 #include "core\Node.h"
+#include "core\CostType.h"
 
-// Allocate 2D distance matrix
-double** Compute_Distances_2DVector(const Node* nodes, int num_nodes);
+// =============================================================================
+// DISTANCE MATRIX
+// =============================================================================
+//
+// One contiguous, row-major block aligned on a cache line. Rows are padded
+// to a whole number of cache lines (stride), so every row starts aligned.
+// Access is a single multiply-add instead of a double pointer chase.
+//
+// Storage type dist_t comes from core/CostType.h (double, float with
+// DIST_FLOAT, or nint-rounded int32_t with COST_INTEGER). Reads widen to
+// cost_t, so sums never lose precision to the storage type.
+//
+// The coordinates are always kept as structure-of-arrays (xs, ys) for the
+// spatial index (utils/SpatialGrid.h).
+//
+// Matrix-free mode (DistMatrix_CreateMatrixFree, selected at runtime): no
+// matrix is stored, data is NULL and DIST computes the distance from the
+// coordinates. Memory is O(N), which
+// makes instances far beyond the N^2 limit reachable. Results are identical
+// to the stored matrix (same rounding to dist_t).
+//
 
-// Allocate 2D ranking matrix  
-int** Distance_Ranking_2DVector(double** dist, int rows, int cols);
+#define DIST_ALIGNMENT 64
 
-// Free 2D arrays
-void Free_2DArray_Double(double** arr, int rows);
-void Free_2DArray_Int(int** arr, int rows);
+typedef struct DistMatrix {
+    int n;              // Number of stations
+    int stride;         // Row length in elements (>= n, padded)
+    dist_t* data;       // [n * stride], DIST_ALIGNMENT-aligned (NULL if matrix-free)
+    double* xs;         // [n] x coordinates
+    double* ys;         // [n] y coordinates
+} DistMatrix;
+
+// Rounding of a Euclidean length to the storage type
+#ifdef COST_INTEGER
+#define DIST_ROUND(len) ((dist_t)((len) + 0.5))  // TSPLIB nint
+#else
+#define DIST_ROUND(len) ((dist_t)(len))
+#endif
+
+// Distance between stations of 0-indexed positions a and b, as a cost_t
+#define DIST(m, a, b) ((m)->data \
+    ? (cost_t)(m)->data[(size_t)(a) * (m)->stride + (b)] \
+    : DistMatrix_Compute((m), (a), (b)))
+
+// Pointer to the 0-indexed row a (stored matrix only, see DistMatrix_FillRow)
+#define DIST_ROW(m, a) ((m)->data + (size_t)(a) * (m)->stride)
+
+// Allocate and fill the Euclidean distance matrix
+DistMatrix* DistMatrix_Create(const Node* nodes, int num_nodes);
+
+// Matrix-free variant: only the coordinates are stored
+DistMatrix* DistMatrix_CreateMatrixFree(const Node* nodes, int num_nodes);
+
+// Distance computed from the coordinates (matrix-free mode)
+cost_t DistMatrix_Compute(const DistMatrix* m, int a, int b);
+
+// Write the n distances of the 0-indexed row a to out. Matrix-free rows are
+// computed 4 stations at a time with AVX (vectorized sqrt) when available.
+void DistMatrix_FillRow(const DistMatrix* m, int a, dist_t* out);
+
+// Free the matrix (NULL is accepted)
+void DistMatrix_Free(DistMatrix* m);
@@ -3,6 +3,8 @@
 
 #define _CRT_SECURE_NO_WARNINGS
 #include "OutputWriter.h"
+#include "core\Assignment.h"
+#include "utils\Bitset.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -12,7 +14,8 @@ void WriteSolutionToFile(
     int total_stations,
     int alpha,
     double best_cost,
-    const int** dist_ranking)
+    const DistMatrix* dist,
+    const Ranking* dist_ranking)
 {
     if (!best_individual || !best_individual->active_ring) {
         fprintf(stderr, "ERROR: Cannot write solution (invalid individual)\n");
@@ -46,19 +49,19 @@ void WriteSolutionToFile(
     }
     fprintf(f, "\n\n");
 
-    // Build is_active map
-    int* is_active = (int*)calloc(total_stations + 1, sizeof(int));
-    if (!is_active) {
-        fprintf(stderr, "ERROR: Memory allocation failed\n");
-        fclose(f);
-        return;
-    }
-
-    for (int i = 0; i < best_individual->ring_size; i++) {
-        int id = best_individual->active_ring[i];
-        if (id > 0 && id <= total_stations) {
-            is_active[id] = 1;
+    // Assignments come from the individual's cache (built here if not attached)
+    Assignment* temp = NULL;
+    const Assignment* assign = best_individual->assign;
+    if (!assign) {
+        temp = Assignment_Create(total_stations);
+        if (!temp) {
+            fprintf(stderr, "ERROR: Memory allocation failed\n");
+            fclose(f);
+            return;
         }
+        Assignment_Build(temp, best_individual->active_ring, best_individual->ring_size,
+                         dist, dist_ranking);
+        assign = temp;
     }
 
     // Write assignments (non-ring nodes -> nearest ring node)
@@ -66,21 +69,9 @@ void WriteSolutionToFile(
     int has_assignments = 0;
     
     for (int station = 1; station <= total_stations; station++) {
-        if (is_active[station]) continue;  // Skip ring nodes
-        
-        // Find nearest ring node using distance ranking
-        const int* neighbors = dist_ranking[station - 1];
-        if (!neighbors) continue;
-        
-        int nearest_ring = -1;
-        for (int j = 0; j < total_stations; j++) {
-            int candidate = neighbors[j];
-            if (candidate >= 1 && candidate <= total_stations && is_active[candidate]) {
-                nearest_ring = candidate;
-                break;
-            }
-        }
+        if (BITSET_TEST(assign->in_ring, station)) continue;  // Skip ring nodes
         
+        int nearest_ring = assign->nearest[station];
         if (nearest_ring > 0) {
             fprintf(f, "%d -> %d\n", station, nearest_ring);
             has_assignments = 1;
@@ -91,7 +82,7 @@ void WriteSolutionToFile(
         fprintf(f, "(no assignments - all nodes in ring)\n");
     }
 
-    free(is_active);
+    Assignment_Destroy(temp);
     fclose(f);
 
     printf("\n[OUTPUT] Solution saved to Genetic_Solution.txt\n");
@@ -12,6 +12,7 @@
 
 #include "core\Individual.h"
 #include "core\Node.h"
+#include "utils\Ranking.h"
 
 // Write complete solution to "Genetic_Solution.txt"
 //
@@ -20,14 +21,18 @@
 //   total_stations   - Total number of stations
 //   alpha            - Alpha parameter
 //   best_cost        - Cost of best solution
-//   dist_ranking     - Distance ranking matrix (for assignments)
+//   dist             - Distance matrix (for assignments)
+//   dist_ranking     - K-nearest ranking (for assignments)
+//
+// Uses best_individual->assign if attached, otherwise builds it temporarily.
 //
 void WriteSolutionToFile(
     const Individual* best_individual,
     int total_stations,
     int alpha,
     double best_cost,
-    const int** dist_ranking
+    const DistMatrix* dist,
+    const Ranking* dist_ranking
 );
 
 #endif // OUTPUT_WRITER_H
@@ -0,0 +1,221 @@
+// utils/Ranking.c
+// Implementation of the k-nearest candidate ranking
+
+#include "Ranking.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+    double value;
+    int index;
+} RankPair;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static int cmp_pair(const void* a, const void* b)
+{
+    double diff = ((const RankPair*)a)->value - ((const RankPair*)b)->value;
+    if (diff < 0) return -1;
+    if (diff > 0) return 1;
+    return ((const RankPair*)a)->index - ((const RankPair*)b)->index;
+}
+
+static int cmp_id(const void* a, const void* b)
+{
+    rank_id_t ia = *(const rank_id_t*)a;
+    rank_id_t ib = *(const rank_id_t*)b;
+    return (ia > ib) - (ia < ib);
+}
+
+// Position of 'id' in a row sorted by id, -1 if absent
+static int find_sorted(const rank_id_t* by_id, int k, int id)
+{
+    int lo = 0, hi = k - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if ((int)by_id[mid] < id) lo = mid + 1;
+        else if ((int)by_id[mid] > id) hi = mid - 1;
+        else return mid;
+    }
+    return -1;
+}
+
+// Partial selection: move the k smallest pairs (cmp_pair order) to the
+// front of the array, in no particular order. Average O(n).
+static void select_smallest(RankPair* pairs, int n, int k)
+{
+    int lo = 0, hi = n - 1;
+
+    while (lo < hi) {
+        RankPair pivot = pairs[(lo + hi) / 2];
+        int i = lo, j = hi;
+        while (i <= j) {
+            while (cmp_pair(&pairs[i], &pivot) < 0) i++;
+            while (cmp_pair(&pairs[j], &pivot) > 0) j--;
+            if (i <= j) {
+                RankPair tmp = pairs[i];
+                pairs[i] = pairs[j];
+                pairs[j] = tmp;
+                i++;
+                j--;
+            }
+        }
+        if (k - 1 <= j) hi = j;
+        else if (k - 1 >= i) lo = i;
+        else break;
+    }
+}
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+Ranking* Ranking_Create(const DistMatrix* dist, int total_stations, int k)
+{
+    if (!dist || total_stations <= 0) return NULL;
+    if (total_stations > RANKING_MAX_STATIONS) {
+        fprintf(stderr, "ERROR: %d stations exceed the ranking id range (%d), "
+                        "rebuild with WIDE_IDS\n",
+                total_stations, RANKING_MAX_STATIONS);
+        return NULL;
+    }
+    if (k <= 0 || k > total_stations) k = total_stations;
+
+    Ranking* r = (Ranking*)calloc(1, sizeof(Ranking));
+    if (!r) return NULL;
+
+    size_t cells = (size_t)total_stations * k;
+    r->total_stations = total_stations;
+    r->k = k;
+    r->ids = (rank_id_t*)malloc(cells * sizeof(rank_id_t));
+    r->sorted_ids = (rank_id_t*)malloc(cells * sizeof(rank_id_t));
+    r->sorted_rank = (rank_id_t*)malloc(cells * sizeof(rank_id_t));
+    RankPair* pairs = (RankPair*)malloc(total_stations * sizeof(RankPair));
+    dist_t* drow = (dist_t*)malloc(total_stations * sizeof(dist_t));
+    int* knn_ids = (int*)malloc(k * sizeof(int));
+    double* knn_dists = (double*)malloc(k * sizeof(double));
+
+    // Truncated rows come from the grid, which also serves the fallback
+    if (k < total_stations) r->grid = SpatialGrid_Create(dist);
+
+    if (!r->ids || !r->sorted_ids || !r->sorted_rank || !pairs || !drow
+        || !knn_ids || !knn_dists) {
+        free(pairs);
+        free(drow);
+        free(knn_ids);
+        free(knn_dists);
+        Ranking_Free(r);
+        return NULL;
+    }
+
+    for (int i = 0; i < total_stations; ++i) {
+        if (r->grid && SpatialGrid_KNearest(r->grid, dist, i + 1, k,
+                                            knn_ids, knn_dists) == k) {
+            for (int j = 0; j < k; ++j) {
+                pairs[j].value = knn_dists[j];
+                pairs[j].index = knn_ids[j];
+            }
+        } else {
+            DistMatrix_FillRow(dist, i, drow);
+            for (int j = 0; j < total_stations; ++j) {
+                pairs[j].value = drow[j];
+                pairs[j].index = j + 1;
+            }
+
+            // Only the k nearest need to be sorted
+            if (k < total_stations) select_smallest(pairs, total_stations, k);
+        }
+        qsort(pairs, k, sizeof(RankPair), cmp_pair);
+
+        rank_id_t* row = r->ids + (size_t)i * k;
+        rank_id_t* by_id = r->sorted_ids + (size_t)i * k;
+        for (int j = 0; j < k; ++j) {
+            row[j] = (rank_id_t)pairs[j].index;
+            by_id[j] = row[j];
+        }
+
+        // Inverse lookup: row sorted by id, with the rank of each id
+        qsort(by_id, k, sizeof(rank_id_t), cmp_id);
+        rank_id_t* rank = r->sorted_rank + (size_t)i * k;
+        for (int j = 0; j < k; ++j) {
+            rank[find_sorted(by_id, k, row[j])] = (rank_id_t)j;
+        }
+    }
+
+    free(pairs);
+    free(drow);
+    free(knn_ids);
+    free(knn_dists);
+    return r;
+}
+
+void Ranking_Free(Ranking* r)
+{
+    if (!r) return;
+    free(r->ids);
+    free(r->sorted_ids);
+    free(r->sorted_rank);
+    SpatialGrid_Free(r->grid);
+    free(r);
+}
+
+// =============================================================================
+// QUERIES
+// =============================================================================
+
+int Ranking_RankOf(const Ranking* r, int station, int candidate)
+{
+    size_t offset = (size_t)(station - 1) * r->k;
+    int pos = find_sorted(r->sorted_ids + offset, r->k, candidate);
+    return (pos >= 0) ? (int)r->sorted_rank[offset + pos] : -1;
+}
+
+int Ranking_FirstActive(
+    const Ranking* r, const uint32_t* active_bits,
+    int station, int skip,
+    const DistMatrix* dist)
+{
+    const rank_id_t* row = RANKING_ROW(r, station);
+    int k = r->k;
+
+#ifdef WIDE_IDS
+#define SCAN_ROW(from) Bitset_FirstInRow(active_bits, row, (from), k)
+#else
+#define SCAN_ROW(from) Bitset_FirstInRow16(active_bits, row, (from), k)
+#endif
+
+    int j = SCAN_ROW(0);
+    while (j >= 0 && (row[j] == station || row[j] == skip)) {
+        j = SCAN_ROW(j + 1);
+    }
+#undef SCAN_ROW
+
+    if (j >= 0) return row[j];
+    if (k == r->total_stations) return 0;
+
+    // None of the k candidates is in the set: search the grid around the
+    // station, bounded by roughly the cost of the bitset scan below
+    if (r->grid) {
+        int budget = r->total_stations / 16 + k;
+        int found = SpatialGrid_NearestActive(r->grid, dist, active_bits,
+                                              station, skip, budget);
+        if (found >= 0) return found;
+    }
+
+    // Sparse set: scan the set itself.
+    // Ties are broken by id, like the ranking rows.
+    int best = 0;
+    double best_dist = 0.0;
+    for (int id = Bitset_Next(active_bits, r->total_stations, 1); id > 0;
+         id = Bitset_Next(active_bits, r->total_stations, id + 1)) {
+        if (id == station || id == skip) continue;
+        double d = (double)DIST(dist, station - 1, id - 1);
+        if (best == 0 || d < best_dist) {
+            best = id;
+            best_dist = d;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,67 @@
+// utils/Ranking.h
+// K-nearest candidate ranking with inverse-rank lookup
+//
+// Row i (station i + 1) lists the k nearest stations of station i + 1 in
+// increasing distance (ties by id), the station itself first. All rows live
+// in one contiguous block of RANK_ID values: memory is O(N * K) instead of
+// the O(N^2) of a full ranking.
+//
+// Out-of-ring assignment almost always stops within the first few entries.
+// When none of the k candidates is in the ring, Ranking_FirstActive falls
+// back to the spatial grid (utils/SpatialGrid.h), then to a scan of the ring
+// bitset if the grid search runs over budget, so results are identical to a
+// full ranking for any k. The grid also builds the truncated rows in
+// O(N * k) instead of O(N^2).
+//
+// Ids are stored as gene_t (core/GeneType.h): uint16_t by default, int32_t
+// with WIDE_IDS.
+
+#ifndef RANKING_H
+#define RANKING_H
+
+#include <stdint.h>
+#include "core\GeneType.h"
+#include "utils\Bitset.h"
+#include "utils\Distance.h"
+#include "utils\SpatialGrid.h"
+
+typedef gene_t rank_id_t;
+#define RANKING_MAX_STATIONS GENE_MAX_STATIONS
+
+// Default candidate count (0 on the command line means full ranking)
+#define RANKING_DEFAULT_K 64
+
+typedef struct Ranking {
+    int total_stations;
+    int k;                  // Candidates per row (total_stations = full)
+    rank_id_t* ids;         // [total_stations * k] candidates by distance
+    rank_id_t* sorted_ids;  // [total_stations * k] same rows sorted by id
+    rank_id_t* sorted_rank; // [total_stations * k] rank of sorted_ids entries
+    SpatialGrid* grid;      // Station grid (NULL for a full ranking)
+} Ranking;
+
+// Row of candidates of 'station' (1-indexed), k entries
+#define RANKING_ROW(r, station) ((r)->ids + (size_t)((station) - 1) * (r)->k)
+
+// Build the k-nearest ranking from the distance matrix.
+// k <= 0 or k >= total_stations gives the full ranking.
+// Returns NULL on allocation failure or if total_stations is too large for
+// rank_id_t.
+Ranking* Ranking_Create(const DistMatrix* dist, int total_stations, int k);
+
+// Free the ranking (NULL is accepted)
+void Ranking_Free(Ranking* r);
+
+// Rank of 'candidate' in the list of 'station' (0 = nearest, the station
+// itself), -1 if it is not among the k nearest. O(log k).
+int Ranking_RankOf(const Ranking* r, int station, int candidate);
+
+// Nearest station of the set to 'station', ignoring 'station' itself and
+// 'skip' (0 to ignore nothing). Returns 0 if the set has no such station.
+int Ranking_FirstActive(
+    const Ranking* r, const uint32_t* active_bits,
+    int station, int skip,
+    const DistMatrix* dist
+);
+
+#endif // RANKING_H
@@ -0,0 +1,284 @@
+// utils/SpatialGrid.c
+// Implementation of the uniform grid and its nearest-neighbour queries
+
+#include "SpatialGrid.h"
+#include "utils\Bitset.h"
+#include <stdlib.h>
+#include <math.h>
+
+// Safety margin on ring bounds (cell edges are recomputed in floating point)
+#define GRID_BOUND_MARGIN 1e-7
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static int clamp_cell(double v, int count)
+{
+    int c = (int)v;
+    if (c < 0) return 0;
+    if (c >= count) return count - 1;
+    return c;
+}
+
+// Cells of ring r around (cx, cy), split into 4 segments (top and bottom
+// rows, left and right columns). Returns 0 if the segment is empty or
+// outside the grid.
+static int ring_segment(
+    const SpatialGrid* g, int cx, int cy, int r, int side,
+    int* x0, int* x1, int* y0, int* y1)
+{
+    switch (side) {
+    case 0:  // Top row
+        *y0 = *y1 = cy - r;
+        *x0 = cx - r; *x1 = cx + r;
+        break;
+    case 1:  // Bottom row
+        if (r == 0) return 0;
+        *y0 = *y1 = cy + r;
+        *x0 = cx - r; *x1 = cx + r;
+        break;
+    case 2:  // Left column
+        if (r == 0) return 0;
+        *x0 = *x1 = cx - r;
+        *y0 = cy - r + 1; *y1 = cy + r - 1;
+        break;
+    default: // Right column
+        if (r == 0) return 0;
+        *x0 = *x1 = cx + r;
+        *y0 = cy - r + 1; *y1 = cy + r - 1;
+        break;
+    }
+
+    if (*x0 < 0) *x0 = 0;
+    if (*y0 < 0) *y0 = 0;
+    if (*x1 > g->cols - 1) *x1 = g->cols - 1;
+    if (*y1 > g->rows - 1) *y1 = g->rows - 1;
+    return (*x0 <= *x1 && *y0 <= *y1);
+}
+
+// Lower bound on the distance from (px, py) to any cell outside the block of
+// rings 0..r. Returns 0 and sets *covered if the block covers the grid.
+static double ring_bound(
+    const SpatialGrid* g, double px, double py, int cx, int cy, int r,
+    int* covered)
+{
+    double b = -1.0;
+    double side;
+
+#define TAKE(v) do { side = (v); if (b < 0 || side < b) b = side; } while (0)
+    if (cx - r > 0)           TAKE(px - (g->min_x + (cx - r) * g->cell));
+    if (cx + r < g->cols - 1) TAKE(g->min_x + (cx + r + 1) * g->cell - px);
+    if (cy - r > 0)           TAKE(py - (g->min_y + (cy - r) * g->cell));
+    if (cy + r < g->rows - 1) TAKE(g->min_y + (cy + r + 1) * g->cell - py);
+#undef TAKE
+
+    *covered = (b < 0);
+    if (b < 0) return 0;
+    b -= GRID_BOUND_MARGIN;
+    return (b > 0) ? b : 0;
+}
+
+// (da, ia) comes after (db, ib) in ranking order
+static int after(double da, int ia, double db, int ib)
+{
+    return da > db || (da == db && ia > ib);
+}
+
+// Max-heap on (dist, id): the root is the worst of the kept candidates
+static void heap_sift_down(int* ids, double* dists, int size, int i)
+{
+    for (;;) {
+        int l = 2 * i + 1, r = l + 1, top = i;
+        if (l < size && after(dists[l], ids[l], dists[top], ids[top])) top = l;
+        if (r < size && after(dists[r], ids[r], dists[top], ids[top])) top = r;
+        if (top == i) return;
+
+        int ti = ids[i]; ids[i] = ids[top]; ids[top] = ti;
+        double td = dists[i]; dists[i] = dists[top]; dists[top] = td;
+        i = top;
+    }
+}
+
+static void heap_sift_up(int* ids, double* dists, int i)
+{
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!after(dists[i], ids[i], dists[parent], ids[parent])) return;
+
+        int ti = ids[i]; ids[i] = ids[parent]; ids[parent] = ti;
+        double td = dists[i]; dists[i] = dists[parent]; dists[parent] = td;
+        i = parent;
+    }
+}
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+SpatialGrid* SpatialGrid_Create(const DistMatrix* dist)
+{
+    if (!dist || !dist->xs || !dist->ys || dist->n <= 0) return NULL;
+
+    int n = dist->n;
+    SpatialGrid* g = (SpatialGrid*)calloc(1, sizeof(SpatialGrid));
+    if (!g) return NULL;
+
+    double min_x = dist->xs[0], max_x = dist->xs[0];
+    double min_y = dist->ys[0], max_y = dist->ys[0];
+    for (int i = 1; i < n; ++i) {
+        if (dist->xs[i] < min_x) min_x = dist->xs[i];
+        if (dist->xs[i] > max_x) max_x = dist->xs[i];
+        if (dist->ys[i] < min_y) min_y = dist->ys[i];
+        if (dist->ys[i] > max_y) max_y = dist->ys[i];
+    }
+
+    // About two stations per cell
+    double w = (max_x > min_x) ? max_x - min_x : 1.0;
+    double h = (max_y > min_y) ? max_y - min_y : 1.0;
+    g->n = n;
+    g->min_x = min_x;
+    g->min_y = min_y;
+    g->cell = sqrt(2.0 * w * h / n);
+    g->cols = (int)(w / g->cell) + 1;
+    g->rows = (int)(h / g->cell) + 1;
+
+    int cells = g->cols * g->rows;
+    g->cell_start = (int*)calloc(cells + 1, sizeof(int));
+    g->cell_ids = (int*)malloc(n * sizeof(int));
+    g->station_cell = (int*)malloc((n + 1) * sizeof(int));
+    if (!g->cell_start || !g->cell_ids || !g->station_cell) {
+        SpatialGrid_Free(g);
+        return NULL;
+    }
+
+    // Counting sort of the stations by cell
+    g->station_cell[0] = 0;
+    for (int i = 0; i < n; ++i) {
+        int cx = clamp_cell((dist->xs[i] - min_x) / g->cell, g->cols);
+        int cy = clamp_cell((dist->ys[i] - min_y) / g->cell, g->rows);
+        g->station_cell[i + 1] = cy * g->cols + cx;
+        g->cell_start[g->station_cell[i + 1] + 1]++;
+    }
+    for (int c = 0; c < cells; ++c) {
+        g->cell_start[c + 1] += g->cell_start[c];
+    }
+    int* fill = (int*)malloc(cells * sizeof(int));
+    if (!fill) {
+        SpatialGrid_Free(g);
+        return NULL;
+    }
+    for (int c = 0; c < cells; ++c) fill[c] = g->cell_start[c];
+    for (int id = 1; id <= n; ++id) {
+        g->cell_ids[fill[g->station_cell[id]]++] = id;
+    }
+    free(fill);
+
+    return g;
+}
+
+void SpatialGrid_Free(SpatialGrid* g)
+{
+    if (!g) return;
+    free(g->cell_start);
+    free(g->cell_ids);
+    free(g->station_cell);
+    free(g);
+}
+
+// =============================================================================
+// QUERIES
+// =============================================================================
+
+int SpatialGrid_KNearest(
+    const SpatialGrid* g, const DistMatrix* dist,
+    int station, int k,
+    int* ids, double* dists)
+{
+    if (!g || k <= 0 || station < 1 || station > g->n) return 0;
+
+    int cell = g->station_cell[station];
+    int cx = cell % g->cols, cy = cell / g->cols;
+    double px = dist->xs[station - 1], py = dist->ys[station - 1];
+    int count = 0;
+
+    for (int r = 0; ; ++r) {
+        for (int side = 0; side < 4; ++side) {
+            int x0, x1, y0, y1;
+            if (!ring_segment(g, cx, cy, r, side, &x0, &x1, &y0, &y1)) continue;
+
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    int c = y * g->cols + x;
+                    for (int e = g->cell_start[c]; e < g->cell_start[c + 1]; ++e) {
+                        int id = g->cell_ids[e];
+                        double d = (double)DIST(dist, station - 1, id - 1);
+
+                        if (count < k) {
+                            ids[count] = id;
+                            dists[count] = d;
+                            heap_sift_up(ids, dists, count++);
+                        } else if (after(dists[0], ids[0], d, id)) {
+                            ids[0] = id;
+                            dists[0] = d;
+                            heap_sift_down(ids, dists, k, 0);
+                        }
+                    }
+                }
+            }
+        }
+
+        int covered;
+        double bound = ring_bound(g, px, py, cx, cy, r, &covered);
+        if (covered) break;
+        if (count == k && dists[0] < (double)DIST_ROUND(bound)) break;
+    }
+
+    return count;
+}
+
+int SpatialGrid_NearestActive(
+    const SpatialGrid* g, const DistMatrix* dist,
+    const uint32_t* bits, int station, int skip,
+    int budget)
+{
+    if (!g || station < 1 || station > g->n) return 0;
+
+    int cell = g->station_cell[station];
+    int cx = cell % g->cols, cy = cell / g->cols;
+    double px = dist->xs[station - 1], py = dist->ys[station - 1];
+    int best = 0;
+    cost_t best_dist = 0;
+
+    for (int r = 0; ; ++r) {
+        for (int side = 0; side < 4; ++side) {
+            int x0, x1, y0, y1;
+            if (!ring_segment(g, cx, cy, r, side, &x0, &x1, &y0, &y1)) continue;
+
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    int c = y * g->cols + x;
+                    int end = g->cell_start[c + 1];
+                    budget -= end - g->cell_start[c];
+
+                    for (int e = g->cell_start[c]; e < end; ++e) {
+                        int id = g->cell_ids[e];
+                        if (!BITSET_TEST(bits, id) || id == station || id == skip) continue;
+
+                        cost_t d = DIST(dist, station - 1, id - 1);
+                        if (best == 0 || d < best_dist || (d == best_dist && id < best)) {
+                            best = id;
+                            best_dist = d;
+                        }
+                    }
+                }
+            }
+        }
+
+        int covered;
+        double bound = ring_bound(g, px, py, cx, cy, r, &covered);
+        if (covered) return best;
+        if (best > 0 && best_dist < (cost_t)DIST_ROUND(bound)) return best;
+        if (budget <= 0) return -1;
+    }
+}
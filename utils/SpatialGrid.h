@@ -0,0 +1,55 @@
+// utils/SpatialGrid.h
+// Uniform grid over station coordinates for nearest-neighbour queries
+//
+// Stations are bucketed into square cells (about two stations per cell) and
+// stored cell by cell in one array (CSR layout). A query visits rings of
+// cells around the query station, nearest ring first, and stops as soon as
+// no unvisited cell can hold a closer station. On spread-out instances this
+// costs O(1) cells per nearest query and O(k) per k-nearest query, instead
+// of the O(N) of a full row.
+//
+// Distances are always read through DIST (utils/Distance.h) and ties are
+// broken by id, so answers are identical to a full sorted ranking row.
+
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <stdint.h>
+#include "utils\Distance.h"
+
+typedef struct SpatialGrid {
+    int n;              // Number of stations
+    int cols, rows;     // Grid size in cells
+    double min_x, min_y;
+    double cell;        // Cell side
+    int* cell_start;    // [cols * rows + 1] first entry of each cell
+    int* cell_ids;      // [n] station ids (1-indexed), grouped by cell
+    int* station_cell;  // [n + 1] cell of each station id
+} SpatialGrid;
+
+// Build the grid over the coordinates of the matrix (dist->xs, dist->ys)
+// Returns NULL on allocation failure.
+SpatialGrid* SpatialGrid_Create(const DistMatrix* dist);
+
+// Free the grid (NULL is accepted)
+void SpatialGrid_Free(SpatialGrid* g);
+
+// The k nearest stations of 'station' (itself included), by distance then
+// id, written UNSORTED to ids / dists (capacity k). Returns the count found.
+int SpatialGrid_KNearest(
+    const SpatialGrid* g, const DistMatrix* dist,
+    int station, int k,
+    int* ids, double* dists
+);
+
+// Nearest station of the set 'bits' to 'station', ignoring 'station' and
+// 'skip' (0 to ignore nothing), ties by id. Gives up after testing 'budget'
+// stations.
+// Returns the id, 0 if the set has no such station, -1 if the budget ran out.
+int SpatialGrid_NearestActive(
+    const SpatialGrid* g, const DistMatrix* dist,
+    const uint32_t* bits, int station, int skip,
+    int budget
+);
+
+#endif // SPATIAL_GRID_H
@@ -17,12 +17,12 @@
 //        ?  ThreadPool_Run(tasks)             ?
 //        ?  ?????????????????????             ?
 //        ?  1. Store tasks globally           ?
-//        ?  2. ReleaseSemaphore(N) ?????????  ? Workers wake up!
+//        ?  2. ReleaseSemaphore(<=N) ???????  ? Workers wake up!
 //        ?  3. WaitForSingleObject(done) ???  ?
 //        ?     (blocks here)               ?  ? Each worker:
 //        ?                                 ?  ?  - InterlockedIncrement(&next_task)
-//        ?                                 ?  ?  - Execute task
-//        ?                                 ?  ?  - InterlockedIncrement(&done_count)
+//        ?                                 ?  ?  - Execute task, until none left
+//        ?                                 ?  ?  - InterlockedDecrement(&awake)
 //        ?                                 ?  ?  - If last: SetEvent(done) ???
 //        ?  4. Returns                        ?
 //        ?                                    ? Workers go back to waiting
@@ -46,9 +46,11 @@
 
 #include "ThreadPool.h"
 #include "evolution\EvolveSpecie.h"
+#include "utils\Workspace.h"
 
 #include <windows.h>
 #include <process.h>    // For _beginthreadex (safer than CreateThread for C runtime)
+#include <stdio.h>
 #include <stdlib.h>
 
 // =============================================================================
@@ -59,17 +61,20 @@
 // Counters use Interlocked operations (atomic, thread-safe).
 
 static EvolveTask* g_tasks = NULL;      // Task array (set by main thread before signaling)
+static PoolJob g_job = NULL;            // Generic job instead of EvolveSpecie (NULL: tasks)
+static void* g_job_context = NULL;      // Argument of g_job
 static int g_task_count = 0;            // Number of tasks this batch
 
 static volatile LONG g_next_task = 0;   // Next task index to grab (atomic counter)
-static volatile LONG g_done_count = 0;  // Number of completed tasks (atomic counter)
+static volatile LONG g_awake = 0;       // Released tickets not handed back yet (atomic counter)
 
 static HANDLE* g_worker_threads = NULL; // Array of thread handles
+static Workspace** g_workspaces = NULL; // Scratch arrays, one per worker
 static int g_num_workers = 0;           // Number of worker threads
 static volatile int g_pool_shutdown = 0;// Flag: 1 = workers should exit
 
 // Synchronization primitives
-static HANDLE g_work_semaphore = NULL;  // Counts available tasks (workers wait on this)
+static HANDLE g_work_semaphore = NULL;  // Wake-up tickets (workers wait on this)
 static HANDLE g_done_event = NULL;      // Signaled when all tasks complete
 static CRITICAL_SECTION g_task_lock;    // (Currently unused, kept for future use)
 
@@ -77,6 +82,16 @@ static CRITICAL_SECTION g_task_lock;    // (Currently unused, kept for future us
 static int g_enable_logs = 0;
 static int g_enable_timers = 0;
 
+// Free the per-worker workspaces (safe if none were created)
+static void free_workspaces(void) {
+    if (!g_workspaces) return;
+    for (int i = 0; i < g_num_workers; i++) {
+        Workspace_Free(g_workspaces[i]);
+    }
+    free(g_workspaces);
+    g_workspaces = NULL;
+}
+
 // =============================================================================
 // WORKER THREAD FUNCTION
 // =============================================================================
@@ -85,19 +100,28 @@ static int g_enable_timers = 0;
 // Equivalent C++ pseudocode:
 //     void worker() {
 //         while (!shutdown) {
-//             semaphore.wait();           // Block until work available
-//             int task = next_task++;     // Grab a task atomically
-//             if (task < task_count) {
-//                 execute(tasks[task]);
-//                 if (++done_count == task_count)
-//                     done_event.signal();
-//             }
+//             semaphore.wait();           // Block until woken for a batch
+//             int task;
+//             while ((task = next_task++) < task_count)
+//                 execute(tasks[task]);   // Grab tasks atomically until none left
+//             if (--awake == 0)           // Last woken worker out
+//                 done_event.signal();
 //         }
 //     }
 //
 
+// Task index of the current batch, on the given workspace
+static void run_task(LONG task_idx, Workspace* ws) {
+    if (g_job) {
+        g_job(g_job_context, (int)task_idx, ws);
+    } else {
+        EvolveTask_Execute(&g_tasks[task_idx], ws, g_enable_logs, g_enable_timers);
+    }
+}
+
 static unsigned __stdcall worker_thread_func(void* arg) {
-    (void)arg;  // Worker ID - unused but available for debugging
+    int worker_id = (int)(intptr_t)arg;
+    Workspace* ws = g_workspaces[worker_id];  // Owned by this worker only
     
     while (!g_pool_shutdown) {
         // -----------------------------------------------------------------
@@ -116,7 +140,7 @@ static unsigned __stdcall worker_thread_func(void* arg) {
         if (wait_result == WAIT_TIMEOUT) continue;
         
         // -----------------------------------------------------------------
-        // GRAB NEXT TASK (ATOMICALLY)
+        // GRAB TASKS (ATOMICALLY) UNTIL NONE LEFT
         // -----------------------------------------------------------------
         // InterlockedIncrement atomically does: return (++g_next_task)
         // We subtract 1 to get the task index (0-based).
@@ -129,43 +153,58 @@ static unsigned __stdcall worker_thread_func(void* arg) {
         //   Worker B (done with 1): returns 5 ? task 4
         //   Worker C (done with 2): returns 6 ? 6 >= 5, no more tasks
         //
-        LONG task_idx = InterlockedIncrement(&g_next_task) - 1;
+        for (;;) {
+            LONG task_idx = InterlockedIncrement(&g_next_task) - 1;
+            if (task_idx >= g_task_count) break;
+            run_task(task_idx, ws);
+        }
         
-        if (task_idx < g_task_count) {
-            // -----------------------------------------------------------------
-            // EXECUTE THE TASK
-            // -----------------------------------------------------------------
-            EvolveTask* task = &g_tasks[task_idx];
-            
-            EvolveSpecie(
-                task->specie, task->pop_size,
-                (const double**)task->dist, (const int**)task->ranking,
-                task->nodes, task->total_stations,
-                task->alpha, task->total_stations,
-                task->mutation_rate, task->elitism,
-                task->add_pct, task->remove_pct, task->swap_pct,
-                task->inv_pct, task->scr_pct, 0.5,
-                g_enable_logs, g_enable_timers
-            );
-            
-            // -----------------------------------------------------------------
-            // SIGNAL COMPLETION
-            // -----------------------------------------------------------------
-            // Atomically increment done counter. If we're the last one,
-            // signal the main thread that all tasks are complete.
-            //
-            LONG done = InterlockedIncrement(&g_done_count);
-            if (done >= g_task_count) {
-                SetEvent(g_done_event);  // Wake up main thread
-            }
+        // -----------------------------------------------------------------
+        // SIGNAL COMPLETION
+        // -----------------------------------------------------------------
+        // Every task was grabbed, and each one is finished once the worker
+        // holding it gets here: the last woken worker out wakes up the main
+        // thread. No ticket of this batch is left in the semaphore then.
+        //
+        if (InterlockedDecrement(&g_awake) == 0) {
+            SetEvent(g_done_event);  // Wake up main thread
         }
-        // If task_idx >= g_task_count, another worker got the last task.
-        // Just loop back and wait for more work.
     }
     
     return 0;
 }
 
+// =============================================================================
+// EvolveTask_Execute - One species, one generation
+// =============================================================================
+void EvolveTask_Execute(const EvolveTask* task, Workspace* ws,
+                        int enable_logs, int enable_timers) {
+    switch (task->engine) {
+    case ENGINE_ANNEALING:
+        AnnealSpecie(task->specie, task->pop_size, task->arena, ws,
+                     task->dist, task->ranking, task->alpha, task->total_stations,
+                     enable_logs);
+        break;
+    case ENGINE_TABU:
+        TabuSpecie(task->specie, task->pop_size, task->arena, ws,
+                   task->dist, task->ranking, task->alpha, task->total_stations,
+                   enable_logs);
+        break;
+    default:
+        EvolveSpecie(
+            task->specie, task->pop_size, task->arena, ws,
+            task->dist, task->ranking, task->local_search, task->elite_search,
+            task->nodes, task->total_stations,
+            task->alpha, task->total_stations,
+            task->mutation_rate, task->elitism,
+            task->add_pct, task->remove_pct, task->swap_pct,
+            task->inv_pct, task->scr_pct, 0.5,
+            enable_logs, enable_timers
+        );
+        break;
+    }
+}
+
 // =============================================================================
 // ThreadPool_Init - Create worker threads
 // =============================================================================
@@ -176,7 +215,7 @@ static unsigned __stdcall worker_thread_func(void* arg) {
 //
 // But we also create synchronization primitives here.
 //
-int ThreadPool_Init(int num_workers) {
+int ThreadPool_Init(int num_workers, int total_stations) {
     g_num_workers = num_workers;
     g_pool_shutdown = 0;
     
@@ -187,13 +226,14 @@ int ThreadPool_Init(int num_workers) {
     // CREATE SEMAPHORE
     // -----------------------------------------------------------------
     // Semaphore with initial count 0, max count 10000.
-    // Workers will wait on this. When we have N tasks, we release N.
+    // Workers will wait on this. For a batch we release one per worker
+    // (at most), whatever the number of tasks.
     // Think of it as a "work ticket dispenser".
     //
     g_work_semaphore = CreateSemaphore(
         NULL,   // Default security
         0,      // Initial count (no work yet)
-        10000,  // Maximum count (more than we'll ever need)
+        10000,  // Maximum count (more than the workers)
         NULL    // Unnamed
     );
     
@@ -218,8 +258,26 @@ int ThreadPool_Init(int num_workers) {
     // _beginthreadex is preferred over CreateThread for C code because
     // it properly initializes the C runtime library for each thread.
     //
+    // -----------------------------------------------------------------
+    // CREATE WORKSPACES
+    // -----------------------------------------------------------------
+    // Allocated once here, so the operators never allocate in the loop.
+    //
+    g_workspaces = (Workspace**)calloc(num_workers, sizeof(Workspace*));
+    if (!g_workspaces) return 0;
+    for (int i = 0; i < num_workers; i++) {
+        g_workspaces[i] = Workspace_Create(total_stations);
+        if (!g_workspaces[i]) {
+            free_workspaces();
+            return 0;
+        }
+    }
+    
     g_worker_threads = (HANDLE*)malloc(num_workers * sizeof(HANDLE));
-    if (!g_worker_threads) return 0;
+    if (!g_worker_threads) {
+        free_workspaces();
+        return 0;
+    }
     
     for (int i = 0; i < num_workers; i++) {
         unsigned tid;  // Thread ID (we don't use it)
@@ -242,6 +300,7 @@ int ThreadPool_Init(int num_workers) {
             }
             free(g_worker_threads);
             g_worker_threads = NULL;
+            free_workspaces();
             return 0;
         }
     }
@@ -250,6 +309,38 @@ int ThreadPool_Init(int num_workers) {
     return 1;
 }
 
+// =============================================================================
+// dispatch - Wake the workers for the current batch and wait for it
+// =============================================================================
+// One ticket per worker (not per task): the woken workers drain the batch,
+// so a batch can be larger than the semaphore maximum.
+//
+static void dispatch(void) {
+    LONG tickets = (g_task_count < g_num_workers) ? g_task_count : g_num_workers;
+    
+    g_next_task = 0;        // Reset task counter
+    g_awake = tickets;
+    
+    // Reset the "all done" event (it might still be signaled from last run)
+    ResetEvent(g_done_event);
+    
+    // ReleaseSemaphore adds 'tickets' to the semaphore, waking up that
+    // many waiting workers. If it fails, no worker is woken: run the batch
+    // here on the first worker's workspace (idle) instead of waiting forever.
+    //
+    if (!ReleaseSemaphore(g_work_semaphore, tickets, NULL)) {
+        fprintf(stderr, "WARNING: Thread pool wake-up failed, running %d tasks serially\n",
+                g_task_count);
+        for (LONG i = 0; i < g_task_count; i++) {
+            run_task(i, g_workspaces[0]);
+        }
+        return;
+    }
+    
+    // Block here until the last worker calls SetEvent(g_done_event).
+    WaitForSingleObject(g_done_event, INFINITE);
+}
+
 // =============================================================================
 // ThreadPool_Run - Submit tasks and wait for completion
 // =============================================================================
@@ -257,36 +348,46 @@ int ThreadPool_Init(int num_workers) {
 //
 // Equivalent C++ pseudocode:
 //     task_queue = tasks;
-//     semaphore.release(count);  // Wake workers
+//     semaphore.release(min(count, workers));  // Wake workers
 //     done_event.wait();         // Block until all done
 //
 void ThreadPool_Run(EvolveTask* tasks, int count, int enable_logs, int enable_timers) {
+    if (count <= 0) return;
+    
     // Set up this batch
+    g_job = NULL;
     g_tasks = tasks;
     g_task_count = count;
-    g_next_task = 0;        // Reset task counter
-    g_done_count = 0;       // Reset completion counter
     g_enable_logs = enable_logs;
     g_enable_timers = enable_timers;
     
-    // Reset the "all done" event (it might still be signaled from last run)
-    ResetEvent(g_done_event);
-    
     // -----------------------------------------------------------------
-    // WAKE UP WORKERS
+    // WAKE UP WORKERS AND WAIT FOR ALL TASKS TO COMPLETE
     // -----------------------------------------------------------------
-    // ReleaseSemaphore adds 'count' to the semaphore, waking up to
-    // 'count' waiting workers. If we have 8 workers and 100 tasks,
-    // all 8 workers wake up and start grabbing tasks.
+    // If we have 8 workers and 100 tasks, all 8 workers wake up and
+    // grab tasks until none are left.
     //
-    ReleaseSemaphore(g_work_semaphore, count, NULL);
-    
-    // -----------------------------------------------------------------
-    // WAIT FOR ALL TASKS TO COMPLETE
-    // -----------------------------------------------------------------
-    // Block here until the last worker calls SetEvent(g_done_event).
-    //
-    WaitForSingleObject(g_done_event, INFINITE);
+    dispatch();
+}
+
+// =============================================================================
+// ThreadPool_RunJobs - Same as ThreadPool_Run with a generic job
+// =============================================================================
+void ThreadPool_RunJobs(PoolJob job, void* context, int count) {
+    if (count <= 0) return;
+
+    g_job = job;
+    g_job_context = context;
+    g_tasks = NULL;
+    g_task_count = count;
+
+    dispatch();
+
+    g_job = NULL;
+}
+
+int ThreadPool_NumWorkers(void) {
+    return g_worker_threads ? g_num_workers : 0;
 }
 
 // =============================================================================
@@ -315,6 +416,7 @@ void ThreadPool_Destroy(void) {
     
     free(g_worker_threads);
     g_worker_threads = NULL;
+    free_workspaces();
     
     // Clean up synchronization primitives
     CloseHandle(g_work_semaphore);
@@ -49,6 +49,12 @@
 
 #include "core\Individual.h"
 #include "core\Node.h"
+#include "utils\Distance.h"
+#include "utils\Ranking.h"
+#include "evolution\SpeciesArena.h"
+#include "local_search\Vnd.h"
+#include "evolution\Trajectory.h"
+#include "utils\Workspace.h"
 
 // =============================================================================
 // EVOLUTION TASK STRUCTURE
@@ -58,35 +64,57 @@
 typedef struct {
     Individual* specie;         // Array of individuals in this species
     int pop_size;               // Number of individuals
-    double** dist;              // Distance matrix (READ-ONLY, shared)
-    int** ranking;              // Distance ranking (READ-ONLY, shared)
+    SpeciesArena* arena;        // Storage of this species (owned by main)
+    const DistMatrix* dist;     // Distance matrix (READ-ONLY, shared)
+    const Ranking* ranking;     // K-nearest ranking (READ-ONLY, shared)
+    const VndConfig* local_search;  // Descent on each child (READ-ONLY, shared)
+    const VndConfig* elite_search;  // Descent on the best elite (READ-ONLY, shared)
     Node* nodes;                // Station data (READ-ONLY, shared)
     int total_stations;         // Number of stations
     int alpha;                  // Cost weighting parameter
     double mutation_rate;       // Probability of mutation
     int elitism;                // Number of elites to preserve
     int add_pct, remove_pct, swap_pct, inv_pct, scr_pct;  // Mutation percentages
+    SpecieEngine engine;        // GA generation, or annealing / tabu call
 } EvolveTask;
 
+// Run one task with the engine it names (worker threads and serial mode)
+void EvolveTask_Execute(const EvolveTask* task, Workspace* ws,
+                        int enable_logs, int enable_timers);
+
+// Generic job: called once per index in [0, count) with the worker's
+// workspace; context is shared (READ-ONLY except for per-index data)
+typedef void (*PoolJob)(void* context, int index, Workspace* ws);
+
 // =============================================================================
 // THREAD POOL API
 // =============================================================================
 
 // Initialize the thread pool with N worker threads.
+// Each worker gets its own Workspace (utils/Workspace.h) sized for
+// total_stations, handed to every EvolveSpecie call it runs.
 // Workers are created and immediately start waiting for tasks.
 // Returns 1 on success, 0 on failure.
-int ThreadPool_Init(int num_workers);
+int ThreadPool_Init(int num_workers, int total_stations);
 
 // Submit an array of tasks and BLOCK until all complete.
 // This is the main entry point called each generation.
 // Flow:
 //   1. Store tasks in global array
-//   2. Signal workers (release semaphore N times)
-//   3. Workers wake up, grab tasks atomically, execute
+//   2. Signal workers (release semaphore once per worker, at most)
+//   3. Workers wake up, grab tasks atomically, execute, until none left
 //   4. Last worker to finish signals completion event
 //   5. This function returns
 void ThreadPool_Run(EvolveTask* tasks, int count, int enable_logs, int enable_timers);
 
+// Same flow for generic jobs (local search at init): run job(context, i, ws)
+// for i in [0, count) on the workers and BLOCK until all complete.
+// Not reentrant: a job must not submit jobs itself.
+void ThreadPool_RunJobs(PoolJob job, void* context, int count);
+
+// Number of running workers (0 before ThreadPool_Init or after a failure)
+int ThreadPool_NumWorkers(void);
+
 // Shutdown the pool: signal workers to exit, wait for them, free resources.
 // Call this once at program end.
 void ThreadPool_Destroy(void);
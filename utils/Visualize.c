@@ -2,6 +2,8 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 #include "Visualize.h"
+#include "core\Assignment.h"
+#include "utils\Bitset.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <float.h>
@@ -9,7 +11,8 @@
 #include <windows.h>
 
 void Visualize_Ring(const Individual* ind, const Node* nodes, int total_stations,
-                    double cost, int alpha, int generation)
+                    double cost, int alpha, int generation,
+                    const DistMatrix* dist, const Ranking* ranking)
 {
     if (!ind || !nodes || ind->ring_size < 2) return;
 
@@ -45,42 +48,20 @@ void Visualize_Ring(const Individual* ind, const Node* nodes, int total_stations
     double scale_y = (height - 2 * margin) / (max_y - min_y + 1);
     double scale = (scale_x < scale_y) ? scale_x : scale_y;
 
-    // Create set of nodes in ring for quick lookup
-    int* in_ring = (int*)calloc(total_stations + 1, sizeof(int));
-    for (int i = 0; i < ind->ring_size; i++) {
-        if (ind->active_ring[i] > 0 && ind->active_ring[i] <= total_stations) {
-            in_ring[ind->active_ring[i]] = 1;
-        }
-    }
-
-    // Compute assignments (non-ring node -> nearest ring node)
-    int* assignments = (int*)calloc(total_stations + 1, sizeof(int));
-    for (int i = 0; i < total_stations; i++) {
-        int node_id = nodes[i].id;
-        if (in_ring[node_id]) {
-            assignments[node_id] = node_id;  // Ring node assigned to itself
-            continue;
-        }
-        
-        // Find nearest ring node
-        double best_dist = DBL_MAX;
-        int best_ring_node = -1;
-        
-        for (int j = 0; j < ind->ring_size; j++) {
-            int ring_id = ind->active_ring[j];
-            if (ring_id <= 0 || ring_id > total_stations) continue;
-            
-            double dx = nodes[i].x - nodes[ring_id - 1].x;
-            double dy = nodes[i].y - nodes[ring_id - 1].y;
-            double d = dx * dx + dy * dy;
-            
-            if (d < best_dist) {
-                best_dist = d;
-                best_ring_node = ring_id;
-            }
+    // Ring membership and assignments come from the individual's cache
+    // (built here if not attached)
+    Assignment* temp = NULL;
+    const Assignment* assign = ind->assign;
+    if (!assign) {
+        temp = Assignment_Create(total_stations);
+        if (!temp) {
+            fclose(f);
+            return;
         }
-        assignments[node_id] = best_ring_node;
+        Assignment_Build(temp, ind->active_ring, ind->ring_size, dist, ranking);
+        assign = temp;
     }
+    const uint32_t* in_ring = assign->in_ring;
 
     // Write HTML header
     fprintf(f, "<!DOCTYPE html>\n<html>\n<head>\n");
@@ -134,9 +115,9 @@ void Visualize_Ring(const Individual* ind, const Node* nodes, int total_stations
     // Draw connections from non-ring nodes to nearest ring node (light gray dashed)
     for (int i = 0; i < total_stations; i++) {
         int node_id = nodes[i].id;
-        if (in_ring[node_id]) continue;
+        if (BITSET_TEST(in_ring, node_id)) continue;
         
-        int best_ring_node = assignments[node_id];
+        int best_ring_node = Assignment_Of(assign, node_id);
         
         if (best_ring_node > 0) {
             double x1 = margin + (nodes[i].x - min_x) * scale;
@@ -177,7 +158,7 @@ void Visualize_Ring(const Individual* ind, const Node* nodes, int total_stations
         if (node_id == 1) {
             color = "#4CAF50";  // Green for depot
             radius = 8;
-        } else if (in_ring[node_id]) {
+        } else if (BITSET_TEST(in_ring, node_id)) {
             color = "#2196F3";  // Blue for ring nodes
             radius = 6;
         } else {
@@ -189,7 +170,7 @@ void Visualize_Ring(const Individual* ind, const Node* nodes, int total_stations
                 x, y, radius, color);
         fprintf(f, "<title>Node %d (%.1f, %.1f)%s</title>\n", 
                 node_id, nodes[i].x, nodes[i].y,
-                in_ring[node_id] ? " [RING]" : "");
+                BITSET_TEST(in_ring, node_id) ? " [RING]" : "");
         fprintf(f, "</circle>\n");
     }
 
@@ -215,9 +196,9 @@ void Visualize_Ring(const Individual* ind, const Node* nodes, int total_stations
     fprintf(f, "<div class='assignment-list'>\n");
     
     for (int i = 1; i <= total_stations; i++) {
-        if (!in_ring[i]) {
+        if (!BITSET_TEST(in_ring, i)) {
             fprintf(f, "<div class='assignment-item'><span class='non-ring-node'>Station %d</span> &rarr; <span class='ring-node'>%d</span></div>\n",
-                    i, assignments[i]);
+                    i, Assignment_Of(assign, i));
         }
     }
     
@@ -250,8 +231,7 @@ void Visualize_Ring(const Individual* ind, const Node* nodes, int total_stations
     fprintf(f, "</div>\n</body>\n</html>\n");
     
     fclose(f);
-    free(in_ring);
-    free(assignments);
+    Assignment_Destroy(temp);
 
     printf("[VISUALIZATION] Saved to %s\n", filename);
     
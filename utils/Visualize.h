@@ -4,10 +4,13 @@
 
 #include "core\Node.h"
 #include "core\Individual.h"
+#include "utils\Ranking.h"
 
 // Generate an HTML file with SVG visualization of the ring
 // Opens the file in the default browser
+// Assignments use ind->assign if attached, otherwise it is built temporarily.
 void Visualize_Ring(const Individual* ind, const Node* nodes, int total_stations,
-                    double cost, int alpha, int generation);
+                    double cost, int alpha, int generation,
+                    const DistMatrix* dist, const Ranking* ranking);
 
 #endif
@@ -0,0 +1,44 @@
+// utils/Workspace.c
+// Implementation of the per-thread scratch arrays
+
+#include "Workspace.h"
+#include "utils\Bitset.h"
+#include "core\Assignment.h"
+#include "core\TwoLevelList.h"
+#include <stdlib.h>
+
+Workspace* Workspace_Create(int total_stations)
+{
+    if (total_stations <= 0) return NULL;
+
+    Workspace* ws = (Workspace*)malloc(sizeof(Workspace));
+    if (!ws) return NULL;
+
+    ws->total_stations = total_stations;
+    ws->bits = (uint32_t*)malloc(BITSET_WORDS(total_stations) * sizeof(uint32_t));
+    ws->ids = (int*)malloc((total_stations + 1) * sizeof(int));
+    ws->lengths = (cost_t*)malloc((total_stations + 1) * sizeof(cost_t));
+    ws->position = (gene_t*)malloc((total_stations + 1) * sizeof(gene_t));
+    ws->assign = Assignment_Create(total_stations);
+    ws->parent_assign = Assignment_Create(total_stations);
+    ws->tour = TwoLevelList_Create(total_stations);
+    if (!ws->bits || !ws->ids || !ws->lengths || !ws->position || !ws->assign ||
+        !ws->parent_assign || !ws->tour) {
+        Workspace_Free(ws);
+        return NULL;
+    }
+    return ws;
+}
+
+void Workspace_Free(Workspace* ws)
+{
+    if (!ws) return;
+    free(ws->bits);
+    free(ws->ids);
+    free(ws->lengths);
+    free(ws->position);
+    Assignment_Destroy(ws->assign);
+    Assignment_Destroy(ws->parent_assign);
+    TwoLevelList_Free(ws->tour);
+    free(ws);
+}
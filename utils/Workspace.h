@@ -0,0 +1,47 @@
+// utils/Workspace.h
+// Per-thread scratch arrays sized for the instance
+//
+// Every genetic operator needs a ring membership bitset, and adding a
+// station also needs a list of the inactive ones; the 2-opt reuses both as
+// don't-look bits and node queue. One workspace per worker
+// thread is created by ThreadPool_Init and handed to EvolveSpecie, which
+// passes it to crossover, mutations and evaluation: the operators never
+// allocate, whatever the number of stations.
+//
+// A workspace has one user at a time (operators do not nest). Functions that
+// take one also accept NULL: a temporary workspace is then allocated for the
+// call, which is only meant for cold paths (reports, visualization).
+
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include <stdint.h>
+#include "core\GeneType.h"
+#include "core\CostType.h"
+
+struct Assignment;
+struct TwoLevelList;
+
+typedef struct Workspace {
+    int total_stations;
+    uint32_t* bits;     // [BITSET_WORDS(total_stations)] ring membership
+    int* ids;           // [total_stations + 1] station list
+    cost_t* lengths;    // [total_stations + 1] ring edge lengths (2-opt)
+    gene_t* position;   // [total_stations + 1] position index for rings
+                        // without their own (local search)
+    struct Assignment* assign;  // Assignment cache for rings without their
+                                // own (membership local search, mutations)
+    struct Assignment* parent_assign;   // Cache of a parent ring, copied into
+                                        // assign for each of its mutated
+                                        // children (EvolveSpecie)
+    struct TwoLevelList* tour;  // Linked tour for local search on large rings
+} Workspace;
+
+// Allocate a workspace for instances of up to total_stations stations
+// (NULL on failure)
+Workspace* Workspace_Create(int total_stations);
+
+// Free the workspace (NULL is accepted)
+void Workspace_Free(Workspace* ws);
+
+#endif // WORKSPACE_H
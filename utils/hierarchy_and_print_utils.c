@@ -1,34 +1,24 @@
 #include "hierarchy_and_print_utils.h"
+#include "utils\Bitset.h"
 #include <stdio.h>
 #include <stdlib.h>
 
 // C implementations for assignment pairs and SVG plotting
-int* BuildAssignmentPairs(const int* active_ring, int ring_size, const int** ranking, int total_stations, int* out_len)
+int* BuildAssignmentPairs(const Assignment* assign, int* out_len)
 {
-    if (!active_ring || ring_size <= 0 || !ranking || total_stations <= 0) {
+    if (!assign || assign->total_stations <= 0) {
         if (out_len) *out_len = 0;
         return NULL;
     }
 
-    int* is_active = (int*)calloc(total_stations + 1, sizeof(int));
-    if (!is_active) { if (out_len) *out_len = 0; return NULL; }
-    for (int i = 0; i < ring_size; ++i) {
-        int id = active_ring[i];
-        if (id >= 1 && id <= total_stations) is_active[id] = 1;
-    }
-
+    int total_stations = assign->total_stations;
     int* pairs = (int*)malloc(2 * total_stations * sizeof(int));
-    if (!pairs) { free(is_active); if (out_len) *out_len = 0; return NULL; }
+    if (!pairs) { if (out_len) *out_len = 0; return NULL; }
     int p = 0;
 
     for (int s = 1; s <= total_stations; ++s) {
-        if (!is_active[s]) {
-            const int* row = ranking[s - 1];
-            int nearest = -1;
-            for (int j = 0; j < total_stations; ++j) {
-                int cand = row[j];
-                if (cand >= 1 && cand <= total_stations && is_active[cand]) { nearest = cand; break; }
-            }
+        if (!BITSET_TEST(assign->in_ring, s)) {
+            int nearest = assign->nearest[s];
             if (nearest > 0) {
                 pairs[p++] = s;
                 pairs[p++] = nearest;
@@ -36,13 +26,12 @@ int* BuildAssignmentPairs(const int* active_ring, int ring_size, const int** ran
         }
     }
 
-    free(is_active);
     if (out_len) *out_len = p;
     if (p == 0) { free(pairs); return NULL; }
     return pairs;
 }
 
-void PlotIndividualSVG_C(const int* active_ring, int ring_size, const Node* node_vector, int num_nodes,
+void PlotIndividualSVG_C(const gene_t* active_ring, int ring_size, const Node* node_vector, int num_nodes,
                          int generation, const int* assignment_pairs, int assignment_len)
 {
     if (!active_ring || ring_size <= 0 || !node_vector || num_nodes <= 0) return;
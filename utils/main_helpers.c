@@ -21,8 +21,8 @@
 
 // Comparison for sorting species by cost (ascending)
 static int compare_species_cost(const void* a, const void* b) {
-    double da = ((const SpeciesCostLocal*)a)->cost;
-    double db = ((const SpeciesCostLocal*)b)->cost;
+    cost_t da = ((const SpeciesCostLocal*)a)->cost;
+    cost_t db = ((const SpeciesCostLocal*)b)->cost;
     if (da < db) return -1;
     if (da > db) return 1;
     return 0;
@@ -56,7 +56,15 @@ void parse_args(
     int* requested_workers,
     int* verbose,
     int* enable_logs,
-    int* enable_timers)
+    int* enable_timers,
+    int* k_nearest,
+    int* matrix_free,
+    int* memo_log2,
+    double* gap_target,
+    VndConfig* vnd_child,
+    VndConfig* vnd_init,
+    VndConfig* vnd_elite,
+    EngineConfig* engines)
 {
     for (int i = 1; i < argc; ++i) {
         // Flag: verbose
@@ -92,6 +100,59 @@ void parse_args(
         else if (strcmp(argv[i], "--timers") == 0) {
             if (enable_timers) *enable_timers = 1;
         }
+        // Flag: candidates per station in the ranking (0 = full)
+        else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc) {
+            if (k_nearest) *k_nearest = atoi(argv[++i]);
+        }
+        // Flag: compute distances on the fly instead of storing the matrix
+        else if (strcmp(argv[i], "--matrix-free") == 0) {
+            if (matrix_free) *matrix_free = 1;
+        }
+        // Flag: fitness memo size as a power of two (0 = disabled)
+        else if (strcmp(argv[i], "--memo") == 0 && i + 1 < argc) {
+            if (memo_log2) *memo_log2 = atoi(argv[++i]);
+        }
+        // Flag: optimality gap target in percent (early stop)
+        else if (strcmp(argv[i], "--gap") == 0 && i + 1 < argc) {
+            if (gap_target) *gap_target = atof(argv[++i]);
+        }
+        // Flag: local search orders (children / initial population / best elite)
+        else if (strcmp(argv[i], "--vnd") == 0 && i + 1 < argc) {
+            ++i;
+            if (vnd_child && !Vnd_ParseOrder(vnd_child, argv[i])) {
+                fprintf(stderr, "WARNING: Unknown --vnd order '%s', keeping default\n", argv[i]);
+            }
+        }
+        else if (strcmp(argv[i], "--vnd-init") == 0 && i + 1 < argc) {
+            ++i;
+            if (vnd_init && !Vnd_ParseOrder(vnd_init, argv[i])) {
+                fprintf(stderr, "WARNING: Unknown --vnd-init order '%s', keeping default\n", argv[i]);
+            }
+        }
+        else if (strcmp(argv[i], "--vnd-elite") == 0 && i + 1 < argc) {
+            ++i;
+            if (vnd_elite && !Vnd_ParseOrder(vnd_elite, argv[i])) {
+                fprintf(stderr, "WARNING: Unknown --vnd-elite order '%s', keeping default\n", argv[i]);
+            }
+        }
+        // Flag: child local search budget
+        else if (strcmp(argv[i], "--vnd-steps") == 0 && i + 1 < argc) {
+            if (vnd_child) vnd_child->max_steps = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--vnd-ms") == 0 && i + 1 < argc) {
+            if (vnd_child) vnd_child->max_ms = atoi(argv[++i]);
+        }
+        // Flag: elite polish budget
+        else if (strcmp(argv[i], "--vnd-elite-ms") == 0 && i + 1 < argc) {
+            if (vnd_elite) vnd_elite->max_ms = atoi(argv[++i]);
+        }
+        // Flag: per-species engines (GA, annealing, tabu search)
+        else if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+            ++i;
+            if (engines && !Engine_ParseList(engines, argv[i])) {
+                fprintf(stderr, "WARNING: Unknown --engine list '%s', keeping default\n", argv[i]);
+            }
+        }
         // Positional: number = generations
         else if (argv[i][0] >= '0' && argv[i][0] <= '9') {
             *max_generations = atoi(argv[i]);
@@ -103,17 +164,18 @@ void evaluate_and_report(
     int gen,
     int NUM_SPECIES,
     int POP_SIZE,
-    double** dist,
-    int** dist_ranking,
+    const DistMatrix* dist,
+    const Ranking* dist_ranking,
     Node* node_vector,
     int total_stations,
     int ALPHA,
     Individual** species,
-    double* old_best_ptr,
+    cost_t* old_best_ptr,
     int* stagnation_count_ptr,
     double* MUTATION_RATE_ptr,
     int enable_logs,
-    int enable_timers)
+    int enable_timers,
+    LowerBound* lower_bound)
 {
     // -------------------------------------------------------------------------
     // Allocate storage for species costs
@@ -130,9 +192,9 @@ void evaluate_and_report(
     if (enable_timers) start = clock();
 
     for (int s = 0; s < NUM_SPECIES; ++s) {
-        double* costs = Total_Cost_Specie(
+        cost_t* costs = Total_Cost_Specie(
             ALPHA, species[s], POP_SIZE, total_stations,
-            (const double**)dist, (const int**)dist_ranking
+            dist, dist_ranking
         );
 
         if (!costs) {
@@ -170,16 +232,25 @@ void evaluate_and_report(
     printf("  Top %d species:\n", top_count);
     for (int i = 0; i < top_count; ++i) {
         printf("    %d. Species %3d: cost = %.2f\n", 
-               i + 1, species_costs[i].species_id, species_costs[i].cost);
+               i + 1, species_costs[i].species_id, (double)species_costs[i].cost);
     }
 
     // Best individual details
-    double best_cost = species_costs[0].cost;
+    cost_t best_cost = species_costs[0].cost;
     int best_species = species_costs[0].species_id;
     int best_idx = species_costs[0].best_idx;
 
     printf("\n  Best: cost=%.2f (species %d, individual %d)\n", 
-           best_cost, best_species, best_idx);
+           (double)best_cost, best_species, best_idx);
+
+    // Optimality gap against the background lower bound
+    if (lower_bound) {
+        LowerBound_SetUpperBound(lower_bound, (double)best_cost);
+        printf("  Lower bound: %.2f (gap %.2f%%, %d iterations)\n",
+               LowerBound_Get(lower_bound),
+               100.0 * LowerBound_Gap(lower_bound, (double)best_cost),
+               LowerBound_Iterations(lower_bound));
+    }
 
     // Show ring if logs enabled
     if (enable_logs && best_idx >= 0) {
@@ -197,23 +268,27 @@ void evaluate_and_report(
     // -------------------------------------------------------------------------
     if (enable_logs && best_cost < *old_best_ptr && best_idx >= 0) {
         Individual* best = &species[best_species][best_idx];
+        Assignment* assign = Assignment_Create(total_stations);
         int assign_len = 0;
-        int* assign_pairs = BuildAssignmentPairs(
-            best->active_ring, best->ring_size,
-            (const int**)dist_ranking, total_stations, &assign_len
-        );
+        int* assign_pairs = NULL;
+        if (assign) {
+            Assignment_Build(assign, best->active_ring, best->ring_size,
+                             dist, dist_ranking);
+            assign_pairs = BuildAssignmentPairs(assign, &assign_len);
+        }
         PlotIndividualSVG_C(
             best->active_ring, best->ring_size,
             node_vector, total_stations, gen, assign_pairs, assign_len
         );
         if (assign_pairs) free(assign_pairs);
+        Assignment_Destroy(assign);
     }
 
     // -------------------------------------------------------------------------
     // Update best and stagnation
     // -------------------------------------------------------------------------
     if (best_cost < *old_best_ptr) {
-        printf("  >>> IMPROVEMENT: %.2f -> %.2f\n", *old_best_ptr, best_cost);
+        printf("  >>> IMPROVEMENT: %.2f -> %.2f\n", (double)*old_best_ptr, (double)best_cost);
         *old_best_ptr = best_cost;
         *stagnation_count_ptr = 0;
         
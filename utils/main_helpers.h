@@ -13,10 +13,14 @@
 #include <stdlib.h>
 #include "core\Individual.h"
 #include "core\Node.h"
+#include "utils\Ranking.h"
+#include "cost\LowerBound.h"
+#include "local_search\Vnd.h"
+#include "evolution\Trajectory.h"
 
 // Structure for tracking species performance
 typedef struct {
-    double cost;       // Best cost in species
+    cost_t cost;       // Best cost in species
     int species_id;    // Species index
     int best_idx;      // Index of best individual
 } SpeciesCostLocal;
@@ -36,6 +40,18 @@ void print_now(const char* label);
 //   -v          Enable verbose output
 //   --logs      Enable detailed logging
 //   --timers    Enable timing information
+//   -k <N>      Keep the N nearest candidates per station (0 = full ranking)
+//   --matrix-free  Compute distances from coordinates (O(N) memory)
+//   --memo <N>  Fitness memo of 2^N slots (0 = disabled)
+//   --gap <P>   Stop once the optimality gap is at most P percent
+//   --vnd <L>       Child local search order, e.g. 2opt,oropt (Vnd_ParseOrder)
+//   --vnd-init <L>  Initial population local search order
+//   --vnd-steps <N> Neighborhood calls per child (0 = until converged)
+//   --vnd-ms <N>    Time per child local search in ms (0 = no limit)
+//   --vnd-elite <L> Order of the best elite polish (default mask,lk)
+//   --vnd-elite-ms <N> Time per elite polish in ms (0 = no limit)
+//   --engine <L>    Engines given to the species in turn, e.g. ga,sa,tabu
+//                   (Engine_ParseList)
 //   <number>    Set max generations (positional)
 //
 void parse_args(
@@ -47,7 +63,15 @@ void parse_args(
     int* requested_workers,
     int* verbose,
     int* enable_logs,
-    int* enable_timers
+    int* enable_timers,
+    int* k_nearest,
+    int* matrix_free,
+    int* memo_log2,
+    double* gap_target,
+    VndConfig* vnd_child,
+    VndConfig* vnd_init,
+    VndConfig* vnd_elite,
+    EngineConfig* engines
 );
 
 // Evaluate all species and report progress
@@ -59,22 +83,24 @@ void parse_args(
 //   4. Optionally generates SVG visualization (if logs enabled)
 //   5. Updates stagnation counter
 //   6. Adjusts mutation rate if stagnating
+//   7. Prints the optimality gap against lower_bound (may be NULL)
 //
 void evaluate_and_report(
     int gen,
     int NUM_SPECIES,
     int POP_SIZE,
-    double** dist,
-    int** dist_ranking,
+    const DistMatrix* dist,
+    const Ranking* dist_ranking,
     Node* node_vector,
     int total_stations,
     int ALPHA,
     Individual** species,
-    double* old_best_ptr,
+    cost_t* old_best_ptr,
     int* stagnation_count_ptr,
     double* MUTATION_RATE_ptr,
     int enable_logs,
-    int enable_timers
+    int enable_timers,
+    LowerBound* lower_bound
 );
 
 #endif // MAIN_HELPERS_H